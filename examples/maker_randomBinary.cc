@@ -52,11 +52,8 @@ int main() {
     builder.add_space();
     int b_val = builder.add(b);
     builder.add_line();
-    // Create a chessboard of bxa size
-    for (int i = 0; i < b_val; i++) {
-      for (int j = 0; j < a_val; j++) builder.add(bin);
-      builder.add_line();
-    }
+    // Create a chessboard of bxa size, a whole row of digits at a time
+    for (int i = 0; i < b_val; i++) builder.add_digits(bin, a_val);
   }
   builder.finalize();
   return 0;
@@ -47,6 +47,31 @@ class TestFileIOError final : public BaseException {
    */
   void add_more_info() final override { this->more_info = this->tmp; }
 };
+/**
+ * @brief CorpusIOError exception is thrown when a corpus file cannot be opened
+ * or read
+ *
+ */
+class CorpusIOError final : public BaseException {
+  std::string tmp;
+
+ public:
+  /**
+   * @brief Construct a new Corpus I O Error object
+   *
+   * @param details A Generic message for exception
+   */
+  // cppcheck-suppress passedByValue
+  explicit CorpusIOError(std::string details)
+      : BaseException("CorpusIOError : Unable to read corpus file"),
+        tmp(details) {}
+  /**
+   * @brief adds more information to exception such as the file and the
+   * reason of the failure.
+   *
+   */
+  void add_more_info() final override { this->more_info = this->tmp; }
+};
 /**
  * @brief Exception that is thrown when a finalized builder is modified with
  * add_line(..)
@@ -99,6 +99,32 @@ class LimitExhaustedError final : public testcaser::exceptions::BaseException {
    */
   void add_more_info() final override { this->more_info = this->tmp; }
 };
+
+/**
+ * @brief Exception that is thrown when the weights of a weighted sampling are
+ * invalid
+ *
+ */
+class WeightError final : public testcaser::exceptions::BaseException {
+  std::string tmp;
+
+ public:
+  /**
+   * @brief Construct a new Weight Error object
+   *
+   * @param details the Generic message for the exception
+   */
+  // cppcheck-suppress passedByValue
+  explicit WeightError(std::string details)
+      : testcaser::exceptions::BaseException(
+            "WeightError : Invalid sampling weights"),
+        tmp(details) {}
+  /**
+   * @brief More information about the weights that caused the exception
+   *
+   */
+  void add_more_info() final override { this->more_info = this->tmp; }
+};
 }  // namespace maker
 }  // namespace exceptions
 }  // namespace testcaser
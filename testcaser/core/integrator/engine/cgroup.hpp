@@ -0,0 +1,197 @@
+/**
+ * Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CGROUP_HPP
+#define CGROUP_HPP
+
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace testcaser {
+namespace internal {
+/**
+ * @brief A cgroup v2 of its own for a judged child, limiting its memory in the
+ * kernel with memory.max and without swap. The cgroup is created under the
+ * cgroup given by the TESTCASER_CGROUP environment variable, or else under the
+ * cgroup of the judge, which must have the memory controller available and be
+ * writable, as a delegated systemd scope is. The kernel enables a controller
+ * for the children of a cgroup only when it holds no process, so a judge in
+ * that cgroup first moves itself into its leaf "judge". This fails when other
+ * processes share the cgroup of the judge, run the judge in a scope of its own
+ * then. Where the cgroup cannot be created it is inactive and the executor
+ * falls back to a resource limit.
+ *
+ */
+class memory_cgroup {
+  std::string path;
+  std::string procs_path;
+
+  static bool write_file(std::string const& file, std::string const& text) {
+    std::ofstream out(file);
+    out << text;
+    out.flush();
+    return static_cast<bool>(out);
+  }
+  static std::string read_file(std::string const& file) {
+    std::ifstream in(file);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+  }
+  static bool has_word(std::string const& text, std::string const& word) {
+    std::istringstream words(text);
+    std::string each;
+    while (words >> each)
+      if (each == word) return true;
+    return false;
+  }
+  // the directory of the cgroup of the judge in the cgroup v2 hierarchy
+  static std::string own_cgroup() {
+    std::ifstream mounts("/proc/self/mounts");
+    std::string device, mount_point, type, rest;
+    std::string root;
+    while (mounts >> device >> mount_point >> type && std::getline(mounts, rest))
+      if (type == "cgroup2") {
+        root = mount_point;
+        break;
+      }
+    if (root.empty()) return "";
+    std::ifstream groups("/proc/self/cgroup");
+    std::string line;
+    while (std::getline(groups, line))
+      if (line.compare(0, 3, "0::") == 0) return root + line.substr(3);
+    return "";
+  }
+  // the cgroup to create the cgroups of the children in, with the memory
+  // controller enabled for its children. Empty when there is none.
+  static std::string delegated_base() {
+    char const* given = getenv("TESTCASER_CGROUP");
+    std::string const own = own_cgroup();
+    std::string const base =
+        given != NULL && *given != '\0' ? std::string(given) : own;
+    if (base.empty()) return "";
+    if (!has_word(read_file(base + "/cgroup.controllers"), "memory")) return "";
+    if (has_word(read_file(base + "/cgroup.subtree_control"), "memory") ||
+        write_file(base + "/cgroup.subtree_control", "+memory"))
+      return base;
+    // refused while the judge is a process of the cgroup
+    if (base != own) return "";
+    std::string const leaf = base + "/judge";
+    if (mkdir(leaf.c_str(), 0755) != 0 && errno != EEXIST) return "";
+    if (!write_file(leaf + "/cgroup.procs", std::to_string(getpid())))
+      return "";
+    return write_file(base + "/cgroup.subtree_control", "+memory") ? base : "";
+  }
+  static unsigned long long next_id() {
+    static std::atomic<unsigned long long> id(0);
+    return id++;
+  }
+
+ public:
+  memory_cgroup(memory_cgroup const&) = delete;
+  memory_cgroup& operator=(memory_cgroup const&) = delete;
+  /**
+   * @brief Construct a new memory cgroup object
+   *
+   * @param limit the memory limit in KB
+   */
+  explicit memory_cgroup(size_t limit) {
+#ifdef __linux__
+    // found once, the judge moves into its leaf at most once
+    static std::string const base = delegated_base();
+    if (base.empty()) return;
+    std::string const created = base + "/testcaser-" +
+                                std::to_string(getpid()) + "-" +
+                                std::to_string(next_id());
+    if (mkdir(created.c_str(), 0755) != 0) return;
+    if (!write_file(created + "/memory.max",
+                    std::to_string(static_cast<unsigned long long>(limit) *
+                                   1024))) {
+      rmdir(created.c_str());
+      return;
+    }
+    // the limit would not be hard if the child could swap
+    write_file(created + "/memory.swap.max", "0");
+    path = created;
+    procs_path = created + "/cgroup.procs";
+#else
+    (void)limit;
+#endif
+  }
+  /**
+   * @brief Was the cgroup created.
+   *
+   * @return true if the memory of the child is limited by the cgroup
+   */
+  bool active() const { return !path.empty(); }
+  /**
+   * @brief Opens the cgroup.procs of the cgroup. A child enters the cgroup
+   * before the exec by writing 0 to it, which is safe after a vfork.
+   *
+   * @return int the descriptor, -1 when the cgroup is inactive
+   */
+  int open_procs() const {
+    return active() ? open(procs_path.c_str(), O_WRONLY | O_CLOEXEC) : -1;
+  }
+  /**
+   * @brief The peak of the memory charged to the cgroup, from memory.peak. It
+   * counts the page cache the child charged, as the pages of the output file it
+   * writes, which the kernel does not report at the time of the peak. A large
+   * output raises the peak by up to its size.
+   *
+   * @return size_t the peak in KB, 0 when the kernel does not report it
+   */
+  size_t peak() const {
+    if (!active()) return 0;
+    std::string const value = read_file(path + "/memory.peak");
+    return static_cast<size_t>(strtoull(value.c_str(), NULL, 10) / 1024);
+  }
+  /**
+   * @brief Was a process of the cgroup killed for exceeding memory.max.
+   *
+   * @return true if the kernel killed the child for its memory
+   */
+  bool oom_killed() const {
+    if (!active()) return false;
+    std::istringstream events(read_file(path + "/memory.events"));
+    std::string key;
+    unsigned long long count;
+    while (events >> key >> count)
+      if (key == "oom_kill" && count > 0) return true;
+    return false;
+  }
+  /**
+   * @brief Destroy the memory cgroup object and removes the cgroup. The child
+   * must have been reaped.
+   *
+   */
+  ~memory_cgroup() {
+    if (active()) rmdir(path.c_str());
+  }
+};
+}  // namespace internal
+}  // namespace testcaser
+#endif
+#endif
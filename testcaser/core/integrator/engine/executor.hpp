@@ -28,11 +28,21 @@
 #include <sys/time.h>
 #include <sys/types.h>
 #include <sys/wait.h>
+#include <time.h>
 #include <unistd.h>
 #include <fstream>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <testcaser/core/integrator/engine/cgroup.hpp>
+#include <testcaser/core/integrator/engine/launcher.hpp>
+#include <testcaser/core/integrator/engine/supervisor.hpp>
 #include <testcaser/core/integrator/result.hpp>
+#include <vector>
 #define SLACK_THRESHOLD (0.005)
+#ifndef SAMPLE_INTERVAL
+#define SAMPLE_INTERVAL (1000)
+#endif
 
 namespace testcaser {
 /**
@@ -53,27 +63,73 @@ struct executor_engine {
    * @param in path of the input file to provide to the binary
    * @param out path of the output file to write binary's output
    * @param mem the memory limit of the binary
-   * @param tim the time limit of the binary in seconds
+   * @param tim the time limit of the binary in milliseconds
    * @param auto_exit_wait if auto exit is false. How long should we wait before
-   * a SIGKILL to kill the binary.
+   * a SIGKILL to kill the binary, in milliseconds.
    * @param auto_exit should we exit the binary as soon as time or memory limit
    * is passed?
+   * @param sample_interval the time between two samples of the memory used by
+   * the binary in microseconds
+   * @param clock the clock the time limit applies to
    * @return testcaser::integrator::IntegrationResult
    */
   static testcaser::integrator::Result for_execution_of(
       std::string bin, std::string in, std::string out, size_t mem, size_t tim,
-      size_t auto_exit_wait, bool auto_exit) {
+      size_t auto_exit_wait, bool auto_exit,
+      size_t sample_interval = SAMPLE_INTERVAL,
+      testcaser::integrator::TimeLimitClock clock =
+          testcaser::integrator::TimeLimitClock::WALL_TIME) {
     if (!executor_engine::is_readable_file(in))
       throw std::runtime_error("The Input file is not readable. " + in);
-    if (!executor_engine::is_readable_binary(bin) &&
-        bin.substr(bin.size() - 3, std::string::npos) != ".py")
-      throw std::runtime_error(
-          "The specified executable file does not exist. " + bin);
     if (!executor_engine::is_readable_file(in) &&
         bin.substr(bin.size() - 3, std::string::npos) == ".py")
       throw std::runtime_error(
           "The Specified python script is not readable or does not exists. " +
           bin);
+    int fin = open(in.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fin < 0) throw std::runtime_error(strerror(errno));
+    try {
+      auto result = executor_engine::for_execution_of(
+          bin, fin, out, mem, tim, auto_exit_wait, auto_exit, sample_interval,
+          clock);
+      close(fin);
+      return result;
+    } catch (...) {
+      close(fin);
+      throw;
+    }
+  }
+  /**
+   * @brief starts the execution of the new child process reading its input
+   * from an open descriptor. The descriptor is rewound to the start before the
+   * run so that the same descriptor can be judged many times.
+   *
+   * @param bin path of the executable to run in the child process.
+   * @param in the descriptor to provide as the stdin of the binary. It is not
+   * closed.
+   * @param out path of the output file to write binary's output
+   * @param mem the memory limit of the binary
+   * @param tim the time limit of the binary in milliseconds
+   * @param auto_exit_wait if auto exit is false. How long should we wait before
+   * a SIGKILL to kill the binary, in milliseconds.
+   * @param auto_exit should we exit the binary as soon as time or memory limit
+   * is passed?
+   * @param sample_interval the time between two samples of the memory used by
+   * the binary in microseconds
+   * @param clock the clock the time limit applies to
+   * @return testcaser::integrator::IntegrationResult
+   */
+  static testcaser::integrator::Result for_execution_of(
+      std::string bin, int in, std::string out, size_t mem, size_t tim,
+      size_t auto_exit_wait, bool auto_exit,
+      size_t sample_interval = SAMPLE_INTERVAL,
+      testcaser::integrator::TimeLimitClock clock =
+          testcaser::integrator::TimeLimitClock::WALL_TIME) {
+    if (!executor_engine::is_readable_binary(bin) &&
+        bin.substr(bin.size() - 3, std::string::npos) != ".py")
+      throw std::runtime_error(
+          "The specified executable file does not exist. " + bin);
+    lseek(in, 0, SEEK_SET);
     std::remove(out.c_str());
     bool is_python_script =
         bin.substr(bin.size() - 3, std::string::npos) == ".py";
@@ -81,123 +137,314 @@ struct executor_engine {
         bin.substr(bin.size() - 6, std::string::npos) == ".class";
     pid_t pid;
     double wll_time = 0;
+    size_t user_time = 0, system_time = 0;
     testcaser::integrator::ExitStatus exit_stat =
         testcaser::integrator::ExitStatus::NONE;
     int exit_code;
     int max_mem = 0;
     int max_rss = 0;
-    pid = fork();
-    if (pid < 0) {
-      perror("Fork Failed. Unable to create the child process.");
-      throw std::runtime_error(strerror(errno));
-    } else if (pid == 0) {
-      int fin = open(in.c_str(), O_RDONLY);
-      int fout = out != "N/A" ? open(out.c_str(), O_CREAT | O_RDWR, 0666)
-                              : STDOUT_FILENO;
-      dup2(fin, STDIN_FILENO);
-      close(fin);
-      printf(">>> Child Process created with pid %d\n", getpid());
-      printf(">>> Setting the time constraint to %lu seconds\n",
-             static_cast<unsigned long>(tim));
-      rlimit trlim;
-      if (auto_exit)
-        trlim.rlim_cur = trlim.rlim_max = tim;
-      else {
-        trlim.rlim_cur = trlim.rlim_max = auto_exit_wait;
-        printf(">>> Auto Exit Wait Time Limit is %lu\n",
-               static_cast<unsigned long>(auto_exit_wait));
-        printf(">>> Auto Exit on Time Limit is turned off\n");
-      }
-      if (setrlimit(RLIMIT_CPU, &trlim) == 0)
-        printf(">>> Process will be killed if not returned before %lu second\n",
-               trlim.rlim_max);
-      else
-        throw std::runtime_error(strerror(errno));
-      printf(">>> Executing %s on child process.\n", bin.c_str());
-      dup2(fout, STDOUT_FILENO);
+    testcaser::integrator::MemorySource memory_source =
+        testcaser::integrator::MemorySource::SAMPLED;
+    // the memory is limited by a cgroup where one can be created, else by
+    // RLIMIT_DATA. The peak of the child counts the peak of the judge it was
+    // started from. The peak of the judge is reset to its current use first,
+    // so that memory the judge has freed does not count.
+    memory_cgroup cgroup(mem);
+    executor_engine::reset_memory_peak();
+    // everything the child needs is prepared here, so that it runs no more
+    // than a few system calls before the exec
+    int fout = out != "N/A"
+                   ? open(out.c_str(), O_CREAT | O_RDWR | O_CLOEXEC, 0666)
+                   : STDOUT_FILENO;
+    if (fout < 0) throw std::runtime_error(strerror(errno));
+    std::string program = bin;
+    std::vector<std::string> args(1, bin);
+    if (is_python_script) {
+      program = "/usr/bin/python3";
+      args.assign({"python3", bin});
+    } else if (is_java_class) {
+      program = "/usr/bin/java";
+      args.assign({"java", bin});
+    }
+    child_launcher launcher(program, args);
+    launcher.redirect_input(in);
+    launcher.redirect_output(fout);
+    // the time limit is enforced by the judge to the millisecond, RLIMIT_CPU
+    // is only a backstop rounded up to the next whole second and one more
+    rlim_t const cpu_backstop =
+        auto_exit ? (tim + 999) / 1000 + 1 : (auto_exit_wait + 999) / 1000;
+    launcher.set_limit(RLIMIT_CPU, cpu_backstop);
+    int const procs = cgroup.open_procs();
+    launcher.enter_cgroup(procs);
+    // a refused allocation would end the program without telling that it was
+    // for its memory, so RLIMIT_DATA is only a backstop at twice the limit
+    // and the verdict comes from the exact peak. The JVM reserves its heap up
+    // front, it is limited by sampling only.
+    if (!is_java_class)
+      launcher.set_memory_backstop(static_cast<rlim_t>(mem) * 2 * 1024);
+    try {
+      pid = launcher.launch();
+    } catch (...) {
       if (fout != STDOUT_FILENO) close(fout);
-      if (!is_python_script && !is_java_class)
-        execl(bin.c_str(), bin.c_str(), (char*)0);
-      else if (is_python_script)
-        execl("/usr/bin/python3", "python3", bin.c_str(), (char*)0);
-      else
-        execl("/usr/bin/java", "java", bin.c_str(), (char*)0);
-      std::runtime_error("Failed to run the child process. exec failed");
-    } else {
-      double start = executor_engine::current_high_precision_time();
-      pid_t cid = waitpid(pid, &exit_code, WNOHANG | WUNTRACED);
-      while (cid == 0 || cid == -1) {
-        if (cid == -1) {
-          printf(">>> Program was killed\n");
-          kill(pid, SIGKILL);
-          break;
-        }
-        int vm = executor_engine::get_virtual_memory_use(pid);
+      if (procs >= 0) close(procs);
+      throw;
+    }
+    if (fout != STDOUT_FILENO) close(fout);
+    if (procs >= 0) close(procs);
+    // read once the child has exec'd, it is at least the peak of the judge the
+    // child started from
+    int const judge_peak = executor_engine::get_memory_peak(getpid());
+    printf(">>> Child Process created with pid %d\n", pid);
+    printf(">>> Setting the time constraint to %lu ms\n",
+           static_cast<unsigned long>(tim));
+    if (!auto_exit) {
+      printf(">>> Auto Exit Wait Time Limit is %lu ms\n",
+             static_cast<unsigned long>(auto_exit_wait));
+      printf(">>> Auto Exit on Time Limit is turned off\n");
+    }
+    printf(">>> Process will be killed if not returned before %lu second\n",
+           static_cast<unsigned long>(cpu_backstop));
+    if (procs >= 0)
+      printf(">>> Memory is limited to %lu KB by a cgroup\n",
+             static_cast<unsigned long>(mem));
+    else if (!is_java_class)
+      printf(">>> Memory is bounded to %lu KB by RLIMIT_DATA\n",
+             static_cast<unsigned long>(mem) * 2);
+    printf(">>> Executing %s on child process.\n", bin.c_str());
+    double start = executor_engine::current_high_precision_time();
+    bool const on_cpu_time =
+        clock == testcaser::integrator::TimeLimitClock::CPU_TIME;
+    double const limit = tim / 1000.0;
+    // a program is hung once it runs past the wait, which is never less than
+    // the limit
+    double const hang_deadline =
+        (auto_exit_wait > tim ? auto_exit_wait : tim) / 1000.0;
+    // the supervisor sleeps in between the events, the parent uses no CPU
+    // while the child runs. A limit on the wall time is a deadline, a limit
+    // on the CPU time is checked on every sample. On the CPU time the deadline
+    // comes back every wait, and the program is hung when its CPU time has
+    // stopped advancing since the last sample.
+    std::unique_ptr<child_supervisor> supervising;
+    try {
+      supervising.reset(new child_supervisor(pid, sample_interval));
+    } catch (...) {
+      // as when the launch fails nothing is left behind, the child that
+      // nothing would wait for is killed and reaped
+      kill(pid, SIGKILL);
+      int status;
+      while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+      }
+      throw;
+    }
+    child_supervisor& supervisor = *supervising;
+    supervisor.set_deadline(on_cpu_time ? hang_deadline : limit);
+    bool overtime = false, hung = false;
+    double cpu_at_sample = -1;
+    for (;;) {
+      child_supervisor::event const happened = supervisor.wait(exit_code);
+      if (happened == child_supervisor::EXITED) break;
+      if (happened == child_supervisor::SAMPLE) {
+        int vm, rss;
+        executor_engine::get_memory_use(pid, vm, rss);
         if (vm > max_mem) max_mem = vm;
-        int rss = executor_engine::get_physical_memory_use(pid);
         if (rss > max_rss) max_rss = rss;
-
         if (max_rss > static_cast<int>(mem)) {
-          exit_stat = testcaser::integrator::ExitStatus::MEMORY_LIMIT_EXCEEDED;
-          kill(pid, SIGKILL);
+          exit_stat =
+              testcaser::integrator::ExitStatus::MEMORY_LIMIT_EXCEEDED;
           printf(
               ">>> Program was killed by SIGKILL for exceeding memory "
               "limits\n");
+          supervisor.kill_child(exit_code);
           break;
         }
-
-        if (executor_engine::current_high_precision_time() - start >
-            tim - SLACK_THRESHOLD) {
-          printf(">>> Time limit Exceeded.\n");
-          if (auto_exit) {
-            printf(">>> Sending SIGKILL to program\n");
-            exit_stat = testcaser::integrator::ExitStatus::TIME_LIMIT_EXCEEDED;
-            kill(pid, SIGKILL);
-            break;
-          }
+        if (!on_cpu_time) continue;
+        double const cpu = executor_engine::cpu_time_of(pid);
+        cpu_at_sample = cpu;
+        if (!overtime && cpu < limit) continue;
+        // past the limit without auto exit, the wait applies to the CPU time
+        if (overtime) {
+          if (cpu < hang_deadline) continue;
+          hung = true;
         }
-        if (executor_engine::current_high_precision_time() - start + tim >
-            auto_exit_wait - SLACK_THRESHOLD) {
-          printf(">>> Child Hung Up. Sending SIGKILL to kill the Program\n");
-          kill(pid, SIGKILL);
-          break;
+      } else if (on_cpu_time) {
+        if (executor_engine::cpu_time_of(pid) > cpu_at_sample) {
+          supervisor.set_deadline(
+              executor_engine::current_high_precision_time() - start +
+              hang_deadline);
+          continue;
         }
-        cid = waitpid(pid, &exit_code, WNOHANG);
+        hung = true;
+      } else if (overtime) {
+        hung = true;
+      }
+      if (hung) {
+        printf(">>> Child Hung Up. Sending SIGKILL to kill the Program\n");
+        exit_stat = testcaser::integrator::ExitStatus::TIME_LIMIT_EXCEEDED;
+        supervisor.kill_child(exit_code);
+        break;
       }
+      printf(">>> Time limit Exceeded.\n");
+      if (auto_exit) {
+        printf(">>> Sending SIGKILL to program\n");
+        exit_stat = testcaser::integrator::ExitStatus::TIME_LIMIT_EXCEEDED;
+        supervisor.kill_child(exit_code);
+        break;
+      }
+      overtime = true;
+      if (!on_cpu_time) supervisor.set_deadline(hang_deadline);
+    }
+    wll_time = executor_engine::current_high_precision_time() - start;
+    rusage const& usage = supervisor.resources();
+    user_time = executor_engine::micros(usage.ru_utime);
+    system_time = executor_engine::micros(usage.ru_stime);
+    if (on_cpu_time && auto_exit &&
+        user_time + system_time > tim * 1000 &&
+        exit_stat == testcaser::integrator::ExitStatus::NONE) {
+      printf(">>> Time limit Exceeded.\n");
+      exit_stat = testcaser::integrator::ExitStatus::TIME_LIMIT_EXCEEDED;
+    }
 
-      int wstatus = exit_code;
-      if (WIFEXITED(wstatus)) {
-        exit_code = WEXITSTATUS(wstatus);
-        if (exit_stat == testcaser::integrator::ExitStatus::NONE &&
-            exit_code == 0)
-          exit_stat = testcaser::integrator::ExitStatus::SUCCESS;
+    long peak = supervisor.resources().ru_maxrss;
+#ifdef __APPLE__
+    peak /= 1024;
+#endif
+    if (cgroup.active() && cgroup.peak() > 0) {
+      max_rss = static_cast<int>(cgroup.peak());
+      memory_source = testcaser::integrator::MemorySource::CGROUP_PEAK;
+    } else if (judge_peak >= 0 && peak > judge_peak) {
+      // the peak of the child is the larger of its own and the judge's, when
+      // it is not the judge's it is the child's own. Otherwise the peak is
+      // unknown and the largest sample is kept.
+      max_rss = static_cast<int>(peak);
+      memory_source = testcaser::integrator::MemorySource::PROCESS_PEAK;
+    }
+    if (cgroup.oom_killed() || max_rss > static_cast<int>(mem)) {
+      if (exit_stat !=
+          testcaser::integrator::ExitStatus::MEMORY_LIMIT_EXCEEDED)
+        printf(">>> Memory limit Exceeded.\n");
+      exit_stat = testcaser::integrator::ExitStatus::MEMORY_LIMIT_EXCEEDED;
+    }
 
-        if (exit_stat == testcaser::integrator::ExitStatus::NONE &&
-            exit_code != 0)
-          exit_stat = testcaser::integrator::ExitStatus::NON_ZERO_EXIT_CODE;
-      } else if (exit_stat == testcaser::integrator::ExitStatus::NONE) {
-        exit_stat = testcaser::integrator::ABNORMAL_EXIT;
-        exit_code = -1;
-      }
+    int wstatus = exit_code;
+    if (WIFEXITED(wstatus)) {
+      exit_code = WEXITSTATUS(wstatus);
+      if (exit_stat == testcaser::integrator::ExitStatus::NONE &&
+          exit_code == 0)
+        exit_stat = testcaser::integrator::ExitStatus::SUCCESS;
 
-      printf(">>> Completed the child process with exit code %d\n", exit_code);
-      double stop = executor_engine::current_high_precision_time();
-      wll_time = stop - start;
+      if (exit_stat == testcaser::integrator::ExitStatus::NONE &&
+          exit_code != 0)
+        exit_stat = testcaser::integrator::ExitStatus::NON_ZERO_EXIT_CODE;
+    } else {
+      if (exit_stat == testcaser::integrator::ExitStatus::NONE)
+        exit_stat = testcaser::integrator::ABNORMAL_EXIT;
+      exit_code = -1;
     }
+
+    printf(">>> Completed the child process with exit code %d\n", exit_code);
     return testcaser::integrator::Result(
-        max_rss, max_mem,
-        static_cast<size_t>((wll_time + SLACK_THRESHOLD) * 1000000),
-        tim * 1000000, mem, exit_stat, exit_code);
+        max_rss, max_mem, static_cast<size_t>(wll_time * 1000000),
+        tim * 1000, mem, exit_stat, exit_code, memory_source, user_time,
+        system_time, clock);
   }
   /**
-   * @brief Returns the current wall time with microsecond precision.
+   * @brief Returns the time of a monotonic clock with microsecond precision.
+   * Unlike the time of the day, it never jumps.
    *
    * @return double the current time.
    */
   static double current_high_precision_time() {
-    timeval time;
-    gettimeofday(&time, 0);
-    return (double)time.tv_sec + (double)time.tv_usec * 0.000001;
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec * 0.000000001;
+  }
+  /**
+   * @brief Returns the CPU time used so far by a running process.
+   *
+   * @param pid the pid of the process
+   * @return double the CPU time in seconds, -1 when it cannot be read
+   */
+  static double cpu_time_of(pid_t pid) {
+#ifdef __linux__
+    clockid_t cpu_clock;
+    timespec used;
+    if (clock_getcpuclockid(pid, &cpu_clock) == 0 &&
+        clock_gettime(cpu_clock, &used) == 0)
+      return (double)used.tv_sec + (double)used.tv_nsec * 0.000000001;
+#else
+    (void)pid;
+#endif
+    return -1;
+  }
+  /**
+   * @brief Converts a time of a rusage to microseconds.
+   *
+   * @param time the time
+   * @return size_t the time in microseconds
+   */
+  static size_t micros(timeval const& time) {
+    return static_cast<size_t>(time.tv_sec) * 1000000 +
+           static_cast<size_t>(time.tv_usec);
+  }
+  /**
+   * @brief Get the virtual and the physical memory used by the pid specified,
+   * reading its status once.
+   *
+   * @param pid the pid of process to monitor
+   * @param virtual_memory the virtual memory used in KB, -1 when unknown
+   * @param physical_memory the physical memory used in KB, -1 when unknown
+   */
+  static void get_memory_use(pid_t pid, int& virtual_memory,
+                             int& physical_memory) {
+    virtual_memory = physical_memory = -1;
+    std::string path = "/proc/" + std::to_string(pid) + "/status";
+    FILE* file = fopen(path.c_str(), "r");
+    if (file == NULL) return;
+    char line[128];
+    while (fgets(line, 128, file) != 0) {
+      if (strncmp(line, "VmSize:", 7) == 0)
+        virtual_memory = executor_engine::parse(line);
+      else if (strncmp(line, "VmRSS:", 6) == 0) {
+        physical_memory = executor_engine::parse(line);
+        break;
+      }
+    }
+    fclose(file);
+  }
+  /**
+   * @brief Get the peak of the physical memory used by the pid specified, its
+   * VmHWM.
+   *
+   * @param pid the pid of process to monitor
+   * @return int the peak in KB, -1 when unknown
+   */
+  static int get_memory_peak(pid_t pid) {
+    std::string path = "/proc/" + std::to_string(pid) + "/status";
+    FILE* file = fopen(path.c_str(), "r");
+    int result = -1;
+    if (file == NULL) return result;
+    char line[128];
+    while (fgets(line, 128, file) != 0) {
+      if (strncmp(line, "VmHWM:", 6) == 0) {
+        result = executor_engine::parse(line);
+        break;
+      }
+    }
+    fclose(file);
+    return result;
+  }
+  /**
+   * @brief Resets the peak of the physical memory of the judge to the memory
+   * it uses now. It is a no-op where /proc/self/clear_refs is not available.
+   *
+   */
+  static void reset_memory_peak() {
+    int const fd = open("/proc/self/clear_refs", O_WRONLY | O_CLOEXEC);
+    if (fd < 0) return;
+    // 5 resets the peak resident set size, a failure leaves the peak as is
+    ssize_t const written = write(fd, "5", 1);
+    (void)written;
+    close(fd);
   }
   /**
    * @brief Get the virtual memory used by the pid specified
@@ -209,6 +456,7 @@ struct executor_engine {
     std::string path = "/proc/" + std::to_string(pid) + "/status";
     FILE* file = fopen(path.c_str(), "r");
     int result = -1;
+    if (file == NULL) return result;
     char line[128];
     while (fgets(line, 128, file) != 0) {
       if (strncmp(line, "VmSize:", 7) == 0) {
@@ -229,6 +477,7 @@ struct executor_engine {
     std::string path = "/proc/" + std::to_string(pid) + "/status";
     FILE* file = fopen(path.c_str(), "r");
     int result = -1;
+    if (file == NULL) return result;
     char line[128];
     while (fgets(line, 128, file) != 0) {
       if (strncmp(line, "VmRSS:", 6) == 0) {
@@ -0,0 +1,208 @@
+/**
+ * Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LAUNCHER_HPP
+#define LAUNCHER_HPP
+
+#ifndef _WIN32
+#include <errno.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#ifdef __linux__
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+namespace testcaser {
+namespace internal {
+/**
+ * @brief Starts a program as a child with its stdin and stdout redirected and
+ * its resource limits set. On Linux the child is a clone(CLONE_VM |
+ * CLONE_VFORK) sharing the memory of the judge until it execs, so starting it
+ * costs the same whatever the size of the judge, unlike a fork that copies
+ * the page tables of the judge. Everything is prepared before the launch, the
+ * child only runs a minimal helper of async signal safe calls before the exec.
+ * Other systems fork and run the same helper.
+ *
+ */
+class child_launcher {
+  static const int MAX_LIMITS = 4;
+  // the child runs on a stack of its own while the judge is suspended
+  static const size_t STACK_SIZE = 64 * 1024;
+
+  std::string path;
+  std::vector<std::string> arguments;
+  std::vector<char*> argv;
+  int input = -1, output = -1, cgroup_procs = -1;
+  int limits = 0;
+  int resources[MAX_LIMITS];
+  rlimit values[MAX_LIMITS];
+  bool has_memory_backstop = false;
+  rlimit memory_backstop;
+  sigset_t judge_mask;
+  // written by the child sharing the memory when the launch fails
+  volatile int failure = 0;
+
+  static int run(void* self) {
+    child_launcher* plan = static_cast<child_launcher*>(self);
+    // a handler of the judge must not run on the memory of the judge, the
+    // ignored signals stay ignored as after a fork
+    for (int sig = 1; sig < NSIG; sig++) {
+      struct sigaction action;
+      if (sigaction(sig, NULL, &action) != 0 || action.sa_handler == SIG_IGN ||
+          action.sa_handler == SIG_DFL)
+        continue;
+      action.sa_handler = SIG_DFL;
+      sigaction(sig, &action, NULL);
+    }
+    if (plan->input >= 0 && plan->input != STDIN_FILENO) {
+      if (dup2(plan->input, STDIN_FILENO) < 0) plan->fail();
+      close(plan->input);
+    }
+    if (plan->output >= 0 && plan->output != STDOUT_FILENO &&
+        dup2(plan->output, STDOUT_FILENO) < 0)
+      plan->fail();
+    // writing 0 to cgroup.procs moves the writing process
+    bool const contained =
+        plan->cgroup_procs >= 0 && write(plan->cgroup_procs, "0", 1) == 1;
+    for (int t = 0; t < plan->limits; t++)
+      if (setrlimit(plan->resources[t], &plan->values[t]) != 0) plan->fail();
+    if (!contained && plan->has_memory_backstop)
+      setrlimit(RLIMIT_DATA, &plan->memory_backstop);
+    sigprocmask(SIG_SETMASK, &plan->judge_mask, NULL);
+    execv(plan->path.c_str(), plan->argv.data());
+    plan->fail();
+    return 127;
+  }
+  void fail() {
+    failure = errno == 0 ? ENOEXEC : errno;
+    _exit(127);
+  }
+
+ public:
+  child_launcher(child_launcher const&) = delete;
+  child_launcher& operator=(child_launcher const&) = delete;
+  /**
+   * @brief Construct a new child launcher object
+   *
+   * @param program the path of the program to exec
+   * @param args the arguments of the program, the first being its name
+   */
+  child_launcher(std::string const& program,
+                 std::vector<std::string> const& args)
+      : path(program), arguments(args) {
+    if (arguments.empty()) arguments.push_back(program);
+    for (size_t t = 0; t < arguments.size(); t++)
+      argv.push_back(const_cast<char*>(arguments[t].c_str()));
+    argv.push_back(NULL);
+  }
+  /**
+   * @brief Set the descriptor to become the stdin of the child.
+   *
+   * @param fd the descriptor, it is closed in the child
+   */
+  void redirect_input(int fd) { input = fd; }
+  /**
+   * @brief Set the descriptor to become the stdout of the child.
+   *
+   * @param fd the descriptor, it should be opened with O_CLOEXEC
+   */
+  void redirect_output(int fd) { output = fd; }
+  /**
+   * @brief Set a resource limit of the child, both soft and hard.
+   *
+   * @param resource the resource, as RLIMIT_CPU
+   * @param value the limit
+   */
+  void set_limit(int resource, rlim_t value) {
+    if (limits == MAX_LIMITS)
+      throw std::length_error("Too many resource limits for the child");
+    resources[limits] = resource;
+    values[limits].rlim_cur = values[limits].rlim_max = value;
+    limits++;
+  }
+  /**
+   * @brief Set the cgroup the child enters before the exec.
+   *
+   * @param procs_fd the descriptor of the cgroup.procs of the cgroup, opened
+   * for writing
+   */
+  void enter_cgroup(int procs_fd) { cgroup_procs = procs_fd; }
+  /**
+   * @brief Set the RLIMIT_DATA of the child for when it could not enter its
+   * cgroup.
+   *
+   * @param bytes the limit in bytes
+   */
+  void set_memory_backstop(rlim_t bytes) {
+    has_memory_backstop = true;
+    memory_backstop.rlim_cur = memory_backstop.rlim_max = bytes;
+  }
+  /**
+   * @brief Starts the child. On Linux the judge is suspended until the child
+   * has exec'd, and a failing exec throws. Elsewhere a failing exec ends the
+   * child with exit code 127.
+   *
+   * @return pid_t the pid of the child
+   */
+  pid_t launch() {
+    // no signal is handled in the child before it has reset the handlers
+    sigset_t all;
+    sigfillset(&all);
+    sigprocmask(SIG_BLOCK, &all, &judge_mask);
+    failure = 0;
+    pid_t pid;
+#ifdef __linux__
+    void* stack = mmap(NULL, STACK_SIZE, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+    if (stack == MAP_FAILED) {
+      int const reason = errno;
+      sigprocmask(SIG_SETMASK, &judge_mask, NULL);
+      throw std::runtime_error(strerror(reason));
+    }
+    pid = clone(&child_launcher::run, static_cast<char*>(stack) + STACK_SIZE,
+                CLONE_VM | CLONE_VFORK | SIGCHLD, this);
+    int const reason = errno;
+    munmap(stack, STACK_SIZE);
+#else
+    pid = fork();
+    if (pid == 0) run(this);
+    int const reason = errno;
+#endif
+    sigprocmask(SIG_SETMASK, &judge_mask, NULL);
+    if (pid < 0) throw std::runtime_error(strerror(reason));
+    if (failure != 0) {
+      int status;
+      while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+      }
+      throw std::runtime_error(
+          std::string("Failed to run the child process. exec failed : ") +
+          strerror(failure));
+    }
+    return pid;
+  }
+};
+}  // namespace internal
+}  // namespace testcaser
+#endif
+#endif
@@ -0,0 +1,304 @@
+/**
+ * Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SUPERVISOR_HPP
+#define SUPERVISOR_HPP
+
+#ifndef _WIN32
+#include <errno.h>
+#include <signal.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include <stdexcept>
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/syscall.h>
+#include <sys/timerfd.h>
+#endif
+
+namespace testcaser {
+namespace internal {
+/**
+ * @brief Waits for the events of a child process without spinning. The
+ * supervisor sleeps until the child exits, a memory sample is due or the
+ * deadline is reached. On Linux the child is watched through a pidfd, or a
+ * signalfd of SIGCHLD on kernels older than 5.3, and the samples and the
+ * deadline are timerfds, all waited on with a single epoll. Other systems
+ * sleep between the samples.
+ *
+ */
+class child_supervisor {
+ public:
+  /**
+   * @brief The events the supervisor wakes up for.
+   *
+   */
+  enum event {
+    /**
+     * @brief The child has exited and was reaped.
+     *
+     */
+    EXITED,
+    /**
+     * @brief A memory sample is due.
+     *
+     */
+    SAMPLE,
+    /**
+     * @brief The deadline was reached.
+     *
+     */
+    DEADLINE
+  };
+
+ private:
+  pid_t pid;
+  long sample_usec;
+  timespec start;
+  rusage usage;
+#ifdef __linux__
+  int poller = -1, sampler = -1, deadline = -1, watcher = -1;
+  bool watches_signal = false;
+  sigset_t previous;
+#else
+  timespec next_sample;
+  timespec deadline_at;
+  bool has_deadline = false;
+#endif
+
+  static timespec now() {
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time;
+  }
+  static timespec after(timespec from, double seconds) {
+    long long const nanos = static_cast<long long>(seconds * 1e9);
+    from.tv_sec += static_cast<time_t>(nanos / 1000000000);
+    from.tv_nsec += static_cast<long>(nanos % 1000000000);
+    if (from.tv_nsec >= 1000000000) {
+      from.tv_sec++;
+      from.tv_nsec -= 1000000000;
+    } else if (from.tv_nsec < 0) {
+      from.tv_sec--;
+      from.tv_nsec += 1000000000;
+    }
+    return from;
+  }
+  static bool before(timespec a, timespec b) {
+    return a.tv_sec < b.tv_sec || (a.tv_sec == b.tv_sec && a.tv_nsec < b.tv_nsec);
+  }
+  // reaps the child if it has exited. A child reaped by someone else, as when
+  // SIGCHLD is ignored, has no status and is reported with -1.
+  bool reaped(int& status) {
+    pid_t const cid = wait4(pid, &status, WNOHANG, &usage);
+    if (cid == pid) return true;
+    if (cid < 0 && errno == ECHILD) {
+      status = -1;
+      return true;
+    }
+    return false;
+  }
+  void fail() {
+    int const reason = errno;
+    this->release();
+    throw std::runtime_error(strerror(reason));
+  }
+  void release() {
+#ifdef __linux__
+    if (poller >= 0) close(poller);
+    if (sampler >= 0) close(sampler);
+    if (deadline >= 0) close(deadline);
+    if (watcher >= 0) close(watcher);
+    poller = sampler = deadline = watcher = -1;
+    if (watches_signal) sigprocmask(SIG_SETMASK, &previous, NULL);
+    watches_signal = false;
+#endif
+  }
+#ifdef __linux__
+  void watch(int fd) {
+    epoll_event interest;
+    memset(&interest, 0, sizeof(interest));
+    interest.events = EPOLLIN;
+    interest.data.fd = fd;
+    if (epoll_ctl(poller, EPOLL_CTL_ADD, fd, &interest) != 0) this->fail();
+  }
+  static void drain(int fd) {
+    char buffer[sizeof(signalfd_siginfo)];
+    while (read(fd, buffer, sizeof(buffer)) > 0) {
+    }
+  }
+#endif
+
+ public:
+  child_supervisor(child_supervisor const&) = delete;
+  child_supervisor& operator=(child_supervisor const&) = delete;
+  /**
+   * @brief Construct a new child supervisor object. It should be created
+   * right after the fork.
+   *
+   * @param child the pid of the child to supervise
+   * @param sample_interval the time between two memory samples in
+   * microseconds
+   */
+  child_supervisor(pid_t child, size_t sample_interval)
+      : pid(child),
+        sample_usec(sample_interval == 0 ? 1
+                                         : static_cast<long>(sample_interval)),
+        start(now()) {
+    memset(&usage, 0, sizeof(usage));
+#ifdef __linux__
+    poller = epoll_create1(EPOLL_CLOEXEC);
+    if (poller < 0) this->fail();
+    sampler = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    deadline = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    if (sampler < 0 || deadline < 0) this->fail();
+    itimerspec period;
+    period.it_interval.tv_sec = sample_usec / 1000000;
+    period.it_interval.tv_nsec = (sample_usec % 1000000) * 1000;
+    period.it_value = period.it_interval;
+    if (timerfd_settime(sampler, 0, &period, NULL) != 0) this->fail();
+#ifdef SYS_pidfd_open
+    watcher = static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+#endif
+    if (watcher < 0) {
+      // SIGCHLD is blocked so that it is only read from the signalfd. A
+      // SIGCHLD that came before is not lost, the child is checked on every
+      // wake up.
+      sigset_t child_signal;
+      sigemptyset(&child_signal);
+      sigaddset(&child_signal, SIGCHLD);
+      if (sigprocmask(SIG_BLOCK, &child_signal, &previous) != 0) this->fail();
+      watches_signal = true;
+      watcher = signalfd(-1, &child_signal, SFD_CLOEXEC | SFD_NONBLOCK);
+      if (watcher < 0) this->fail();
+    }
+    this->watch(watcher);
+    this->watch(sampler);
+    this->watch(deadline);
+#else
+    next_sample = after(start, sample_usec / 1e6);
+#endif
+  }
+  /**
+   * @brief Sets the deadline, replacing the previous one.
+   *
+   * @param seconds the deadline in seconds since the supervisor was created
+   */
+  void set_deadline(double seconds) {
+    timespec const at = after(start, seconds > 0 ? seconds : 0);
+#ifdef __linux__
+    itimerspec once;
+    memset(&once, 0, sizeof(once));
+    once.it_value = at;
+    // a zero time disarms the timer, the start itself is never zero
+    if (timerfd_settime(deadline, TFD_TIMER_ABSTIME, &once, NULL) != 0)
+      throw std::runtime_error(strerror(errno));
+#else
+    deadline_at = at;
+    has_deadline = true;
+#endif
+  }
+  /**
+   * @brief Sleeps until the next event. The exit of the child comes first
+   * when events happen together, then the deadline.
+   *
+   * @param status the wait status of the child when it has exited
+   * @return event the event
+   */
+  event wait(int& status) {
+    for (;;) {
+#ifdef __linux__
+      epoll_event ready[3];
+      int const count = epoll_wait(poller, ready, 3, -1);
+      if (count < 0) {
+        if (errno == EINTR) continue;
+        throw std::runtime_error(strerror(errno));
+      }
+      bool sample_due = false, deadline_due = false;
+      for (int t = 0; t < count; t++) {
+        uint64_t expirations;
+        if (ready[t].data.fd == sampler) {
+          sample_due = read(sampler, &expirations, sizeof(expirations)) > 0;
+        } else if (ready[t].data.fd == deadline) {
+          deadline_due = read(deadline, &expirations, sizeof(expirations)) > 0;
+        } else if (watches_signal) {
+          drain(watcher);
+        }
+      }
+      if (this->reaped(status)) return EXITED;
+      if (deadline_due) return DEADLINE;
+      if (sample_due) return SAMPLE;
+#else
+      if (this->reaped(status)) return EXITED;
+      timespec const current = now();
+      if (has_deadline && !before(current, deadline_at)) {
+        has_deadline = false;
+        return DEADLINE;
+      }
+      if (!before(current, next_sample)) {
+        next_sample = after(current, sample_usec / 1e6);
+        return SAMPLE;
+      }
+      timespec wake = has_deadline && before(deadline_at, next_sample)
+                          ? deadline_at
+                          : next_sample;
+      long long const nanos =
+          (wake.tv_sec - current.tv_sec) * 1000000000LL +
+          (wake.tv_nsec - current.tv_nsec);
+      timespec pause;
+      pause.tv_sec = static_cast<time_t>(nanos / 1000000000);
+      pause.tv_nsec = static_cast<long>(nanos % 1000000000);
+      nanosleep(&pause, NULL);
+#endif
+    }
+  }
+  /**
+   * @brief Kills the child and waits for it, so that it leaves no zombie.
+   *
+   * @param status the wait status of the child
+   */
+  void kill_child(int& status) {
+    kill(pid, SIGKILL);
+    while (wait4(pid, &status, 0, &usage) < 0) {
+      if (errno != EINTR) {
+        status = -1;
+        return;
+      }
+    }
+  }
+  /**
+   * @brief The resources used by the child, filled once it is reaped. Its
+   * ru_maxrss is the exact peak of the memory of the child.
+   *
+   * @return rusage const& the resources used
+   */
+  rusage const& resources() const { return usage; }
+  /**
+   * @brief Destroy the child supervisor object. The signal mask is restored.
+   *
+   */
+  ~child_supervisor() { this->release(); }
+};
+}  // namespace internal
+}  // namespace testcaser
+#endif
+#endif
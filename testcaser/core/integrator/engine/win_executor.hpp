@@ -70,16 +70,22 @@ struct executor_engine {
    * @param in path of the input file to provide to the binary
    * @param out path of the output file to write binary's output
    * @param mem the memory limit of the binary
-   * @param tim the time limit of the binary in seconds
+   * @param tim the time limit of the binary in milliseconds
    * @param auto_exit_wait if auto exit is false. How long should we wait before
-   * a SIGKILL to kill the binary.
+   * a SIGKILL to kill the binary, in milliseconds.
    * @param auto_exit should we exit the binary as soon as time or memory limit
    * is passed?
+   * @param sample_interval unused, the memory is read once the binary exits
+   * @param clock the clock reported with the result, the time limit is always
+   * checked on the wall time
    * @return testcaser::integrator::IntegrationResult
    */
   static testcaser::integrator::Result for_execution_of(
       std::string bin, std::string in, std::string out, size_t mem, size_t tim,
-      size_t auto_exit_wait, bool auto_exit) {
+      size_t auto_exit_wait, bool auto_exit, size_t sample_interval = 1000,
+      testcaser::integrator::TimeLimitClock clock =
+          testcaser::integrator::TimeLimitClock::WALL_TIME) {
+    (void)sample_interval;
     if (!executor_engine::is_readable_file(in))
       throw std::runtime_error("The Input file is not readable. " + in);
     if (!executor_engine::is_readable_binary(bin) &&
@@ -148,13 +154,14 @@ struct executor_engine {
      * soon as the memory limit is reached. This is because you have not figured
      * out how to monitor child memory usage while it is running.
      */
-    DWORD status = WaitForSingleObject(pi.hProcess, tim * 1000);
+    DWORD status = WaitForSingleObject(pi.hProcess, static_cast<DWORD>(tim));
     bool extended_run = false;
     bool was_killed = false;
     DWORD extended_status;
     if (!auto_exit && status == WAIT_TIMEOUT) {
       extended_run = true;
-      extended_status = WaitForSingleObject(pi.hProcess, auto_exit_wait * 1000);
+      extended_status = WaitForSingleObject(pi.hProcess,
+                                            static_cast<DWORD>(auto_exit_wait));
       if (extended_status == WAIT_TIMEOUT) was_killed = true;
     }
 
@@ -169,8 +176,8 @@ struct executor_engine {
       printf(">>> Time limit Exceeded.\n");
       if (!auto_exit) {
         printf(
-            ">>> Auto Exit was disabled. Waited %u seconds before force kill\n",
-            auto_exit_wait);
+            ">>> Auto Exit was disabled. Waited %lu ms before force kill\n",
+            static_cast<unsigned long>(auto_exit_wait));
         if (extended_status == WAIT_TIMEOUT)
           printf(">>> Child Hung Up. Killed Forcefully\n");
         else
@@ -194,8 +201,14 @@ struct executor_engine {
     DWORD dummy = sizeof(pmc);
     GetProcessMemoryInfo(
         pi.hProcess, reinterpret_cast<PPROCESS_MEMORY_COUNTERS>(&pmc), dummy);
-    max_rss = pmc.WorkingSetSize / 1024;
+    max_rss = pmc.PeakWorkingSetSize / 1024;
     max_mem = pmc.PeakPagefileUsage / 1024;
+    FILETIME created, exited, kernel, user;
+    size_t user_time = 0, system_time = 0;
+    if (GetProcessTimes(pi.hProcess, &created, &exited, &kernel, &user)) {
+      user_time = executor_engine::micros(user);
+      system_time = executor_engine::micros(kernel);
+    }
     if (ret_code != 0 &&
         exit_stat == testcaser::integrator::ExitStatus::SUCCESS)
       exit_stat = testcaser::integrator::ExitStatus::NON_ZERO_EXIT_CODE;
@@ -206,7 +219,20 @@ struct executor_engine {
     return testcaser::integrator::Result(
         max_rss, max_mem,
         static_cast<size_t>((wll_time + SLACK_THRESHOLD) * 1000000),
-        tim * 1000000, mem, exit_stat, exit_code);
+        tim * 1000, mem, exit_stat, exit_code,
+        testcaser::integrator::MemorySource::PROCESS_PEAK, user_time,
+        system_time, clock);
+  }
+  /**
+   * @brief Converts a time of GetProcessTimes to microseconds.
+   *
+   * @param time the time in units of 100 nanoseconds
+   * @return size_t the time in microseconds
+   */
+  static size_t micros(FILETIME const& time) {
+    uint64_t const ticks = (static_cast<uint64_t>(time.dwHighDateTime) << 32) |
+                           static_cast<uint64_t>(time.dwLowDateTime);
+    return static_cast<size_t>(ticks / 10);
   }
 
   /**
@@ -21,8 +21,10 @@
 #else
 #include <testcaser/core/integrator/engine/win_executor.hpp>
 #endif
+#include <memory>
 #include <testcaser/core/integrator/result.hpp>
 #include <testcaser/core/maker/builder.hpp>
+#include <testcaser/core/maker/sinks.hpp>
 
 namespace testcaser {
 /**
@@ -38,9 +40,11 @@ namespace integrator {
  */
 
 class VirtualJudge {
-  size_t memory_limit, time_limit, auto_exit_wait;
+  size_t memory_limit, time_limit, auto_exit_wait, sample_interval;
+  TimeLimitClock limit_clock;
   bool auto_exit;
   std::string input, output, binary;
+  std::shared_ptr<testcaser::maker::sinks::BaseSink> input_sink;
 
  public:
   /**
@@ -53,9 +57,11 @@ class VirtualJudge {
    */
   VirtualJudge() : input("N/A"), output("N/A"), binary("N/A") {
     auto_exit = true;
-    auto_exit_wait = 30;        // 30 sec
+    auto_exit_wait = 30000;     // 30 sec
     memory_limit = 256 * 1024;  // 256 MB
-    time_limit = 1;             // 1 sec
+    time_limit = 1000;          // 1 sec
+    sample_interval = 1000;     // 1 ms
+    limit_clock = TimeLimitClock::WALL_TIME;
   }
   /**
    * @brief Set the memory limit to the program to execute.
@@ -78,7 +84,20 @@ class VirtualJudge {
    * construction.
    */
   VirtualJudge set_time_limit(size_t ssec) {
-    time_limit = ssec == 0 ? 1 : ssec;
+    time_limit = ssec == 0 ? 1000 : ssec * 1000;
+    return *this;
+  }
+  /**
+   * @brief Set the time limit to the program to execute in milliseconds. The
+   * limit is enforced to the millisecond by the judge.
+   *
+   * @param msec the allocated time in milliseconds for program to execute. It
+   * must be atleast 1 millisecond
+   * @return VirtualJudge the current (this) object for builder syntax of
+   * construction.
+   */
+  VirtualJudge set_time_limit_ms(size_t msec) {
+    time_limit = msec == 0 ? 1 : msec;
     return *this;
   }
   /**
@@ -92,7 +111,51 @@ class VirtualJudge {
    * construction.
    */
   VirtualJudge set_auto_exit_time_limit(size_t ssec) {
-    time_limit = ssec > time_limit ? ssec : time_limit;
+    return this->set_auto_exit_time_limit_ms(ssec == 0 ? 1000 : ssec * 1000);
+  }
+  /**
+   * @brief Set the auto exit time limit to the program to execute in
+   * milliseconds.
+   *
+   * @param msec the allocated time in milliseconds for program to execute even
+   * after it passed the time limit and auto exit is false. After this time
+   * SIGKILL is bound to kill the child. It must be more than time limit.
+   * @return VirtualJudge the current (this) object for builder syntax of
+   * construction.
+   */
+  VirtualJudge set_auto_exit_time_limit_ms(size_t msec) {
+    auto_exit_wait = msec > time_limit ? msec : time_limit;
+    return *this;
+  }
+  /**
+   * @brief Set the time between two samples of the memory used by the program.
+   * The judge sleeps in between, so a longer interval uses less CPU but may
+   * miss short peaks of memory. It is not used on Windows.
+   *
+   * @param usec the time between two samples in microseconds. It must be
+   * atleast 1 microsecond
+   * @return VirtualJudge the current (this) object for builder syntax of
+   * construction.
+   */
+  VirtualJudge set_sampling_interval(size_t usec) {
+    sample_interval = usec == 0 ? 1 : usec;
+    return *this;
+  }
+  /**
+   * @brief Set the clock the time limit applies to. The wall time is the
+   * default, the CPU time (user and system time) is not changed by the load of
+   * the machine. On the CPU time the judge checks every auto exit wait, or
+   * time limit when it is longer, that the CPU time of the program is still
+   * advancing, and kills a program that has stopped as having exceeded the
+   * time limit. On Windows the time limit
+   * is always checked on the wall time.
+   *
+   * @param clock the clock the time limit applies to
+   * @return VirtualJudge the current (this) object for builder syntax of
+   * construction.
+   */
+  VirtualJudge set_time_limit_clock(TimeLimitClock clock) {
+    limit_clock = clock;
     return *this;
   }
   /**
@@ -105,6 +168,26 @@ class VirtualJudge {
    */
   VirtualJudge set_input_file(const std::string &path) {
     input = path;
+    input_sink.reset();
+    return *this;
+  }
+  /**
+   * @brief Set the input source to a sink written by a TestCaseBuilder, such
+   * as testcaser::maker::sinks::MemfdSink. The descriptor of the sink is given
+   * straight to the program as stdin, without writing and reopening a file.
+   *
+   * @param sink the sink to read the input from. It must have a descriptor.
+   * @return VirtualJudge the current (this) object for builder syntax of
+   * construction.
+   */
+  VirtualJudge set_input_sink(
+      std::shared_ptr<testcaser::maker::sinks::BaseSink> const &sink) {
+    if (!sink || sink->descriptor() < 0)
+      throw std::runtime_error(
+          "The input sink cannot be read back. Use a sink with a descriptor "
+          "such as MemfdSink or set_input_file with the path of the file.");
+    input_sink = sink;
+    input = sink->name();
     return *this;
   }
   /**
@@ -153,10 +236,19 @@ class VirtualJudge {
       throw std::runtime_error(
           "Executing incomplete executor. Make sure you have set input "
           " and binary atleast before calling execute.");
-    } else
+    }
+#ifndef _WIN32
+    if (input_sink)
       return testcaser::internal::executor_engine::for_execution_of(
-          binary, input, output, memory_limit, time_limit, auto_exit_wait,
-          auto_exit);
+          binary, input_sink->descriptor(), output, memory_limit, time_limit,
+          auto_exit_wait, auto_exit, sample_interval, limit_clock);
+#else
+    if (input_sink)
+      throw std::runtime_error("Input sinks are not supported on Windows.");
+#endif
+    return testcaser::internal::executor_engine::for_execution_of(
+        binary, input, output, memory_limit, time_limit, auto_exit_wait,
+        auto_exit, sample_interval, limit_clock);
   }
 };
 }  // namespace integrator
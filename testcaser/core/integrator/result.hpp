@@ -59,6 +59,50 @@ enum ExitStatus {
    */
   NONE
 };
+/**
+ * @brief Enum about where the physical memory used by the program was
+ * measured.
+ *
+ */
+enum MemorySource {
+  /**
+   * @brief The largest of the samples taken while the program ran. A short
+   * peak in between two samples is missed.
+   *
+   */
+  SAMPLED,
+  /**
+   * @brief The exact peak of the program reported by the kernel when it
+   * exited, the ru_maxrss of wait4() or the peak working set on Windows.
+   *
+   */
+  PROCESS_PEAK,
+  /**
+   * @brief The exact peak of the memory charged to the cgroup of the program,
+   * its memory.peak. It includes the page cache of the output the program
+   * wrote.
+   *
+   */
+  CGROUP_PEAK
+};
+/**
+ * @brief Enum about the clock the time limit of the program applies to.
+ *
+ */
+enum TimeLimitClock {
+  /**
+   * @brief The wall time from the start to the exit of the program. It grows
+   * when the program waits or is descheduled on a loaded machine.
+   *
+   */
+  WALL_TIME,
+  /**
+   * @brief The CPU time of the program, its user time and system time. It is
+   * not changed by other programs running on the machine.
+   *
+   */
+  CPU_TIME
+};
 /**
  * @brief The Wrapper that holds the complete result about the running of the
  * program  as child process
@@ -67,9 +111,12 @@ enum ExitStatus {
 
 class Result {
   size_t runtime_memory, virtual_memory, time_taken;
+  size_t user_time, system_time;
   size_t allocated_time, allocated_memory;
   ExitStatus exit_status;
   int exit_code;
+  MemorySource memory_source;
+  TimeLimitClock limit_clock;
 
  public:
   /**
@@ -84,10 +131,18 @@ class Result {
    * Virtual Memory
    * @param exit_stats The exit status. It is the final verdict of the program.
    * @param exit_c the process returned exit code.
+   * @param memory_src where the physical memory used was measured.
+   * @param userTime The time spent by the process in user mode in
+   * micro-seconds
+   * @param systemTime The time spent by the kernel for the process in
+   * micro-seconds
+   * @param clock The clock the allocated time applies to.
    */
   Result(size_t runtimeMemory, size_t virtualMemory, size_t runtime,
          size_t allocatedTime, size_t allocatedMemory, ExitStatus exit_stats,
-         int exit_c) {
+         int exit_c, MemorySource memory_src = MemorySource::SAMPLED,
+         size_t userTime = 0, size_t systemTime = 0,
+         TimeLimitClock clock = TimeLimitClock::WALL_TIME) {
     runtime_memory = runtimeMemory;
     virtual_memory = virtualMemory;
     time_taken = runtime;
@@ -95,6 +150,10 @@ class Result {
     allocated_memory = allocatedMemory;
     exit_status = exit_stats;
     exit_code = exit_c;
+    memory_source = memory_src;
+    user_time = userTime;
+    system_time = systemTime;
+    limit_clock = clock;
   }
   /**
    * @brief parses ExitStatus into a message
@@ -121,6 +180,24 @@ class Result {
     }
     return "Unknown. Unknown. No status was reported";
   }
+  /**
+   * @brief parses MemorySource into a message
+   *
+   * @param source the object to parse.
+   * @return std::string the parsed message.
+   */
+  std::string parse_memory_source(
+      testcaser::integrator::MemorySource source) const {
+    switch (source) {
+      case testcaser::integrator::MemorySource::SAMPLED:
+        return "Largest sample";
+      case testcaser::integrator::MemorySource::PROCESS_PEAK:
+        return "Peak of the process";
+      case testcaser::integrator::MemorySource::CGROUP_PEAK:
+        return "Peak of the cgroup";
+    }
+    return "Unknown";
+  }
   /**
    * @brief Formats and prints the result on stdout (console)
    *
@@ -133,6 +210,8 @@ class Result {
     std::cout << "Physical Memory Used    : " << runtime_memory << " KB ("
               << runtime_memory / 1024.0 << " MB)"
               << "\n";
+    std::cout << "Physical Memory Source  : "
+              << parse_memory_source(memory_source) << "\n";
     std::cout << "Virtual Memory Used     : " << virtual_memory << " KB ("
               << virtual_memory / 1024.0 << " MB)"
               << "\n";
@@ -140,9 +219,19 @@ class Result {
               << static_cast<double>(allocated_time) / 1000000.0
               << " second(s) "
               << "\n";
+    std::cout << "Time Limit Applies To   : "
+              << (limit_clock == TimeLimitClock::CPU_TIME ? "CPU Time"
+                                                          : "Wall Time")
+              << "\n";
     std::cout << "Execution Time          : "
               << static_cast<double>(time_taken) / 1000000.0 << " second(s) "
               << "\n";
+    std::cout << "User Time               : "
+              << static_cast<double>(user_time) / 1000000.0 << " second(s) "
+              << "\n";
+    std::cout << "System Time             : "
+              << static_cast<double>(system_time) / 1000000.0 << " second(s) "
+              << "\n";
     std::cout << "Exit Code               : " << exit_code << "\n";
     std::cout << "Remark                  : " << parse_exit_status(exit_status)
               << "\n";
@@ -154,6 +243,40 @@ class Result {
    * @return double the execution time of the program.
    */
   double get_execution_time() const { return time_taken / 1000000.0; }
+  /**
+   * @brief Get the wall time of the program in seconds, measured on a
+   * monotonic clock. It is the execution time.
+   *
+   * @return double the wall time of the program.
+   */
+  double get_wall_time() const { return time_taken / 1000000.0; }
+  /**
+   * @brief Get the time spent by the program in user mode in seconds
+   *
+   * @return double the user time of the program.
+   */
+  double get_user_time() const { return user_time / 1000000.0; }
+  /**
+   * @brief Get the time spent by the kernel for the program in seconds
+   *
+   * @return double the system time of the program.
+   */
+  double get_system_time() const { return system_time / 1000000.0; }
+  /**
+   * @brief Get the CPU time of the program in seconds, its user time and its
+   * system time.
+   *
+   * @return double the CPU time of the program.
+   */
+  double get_cpu_time() const { return (user_time + system_time) / 1000000.0; }
+  /**
+   * @brief Get the clock the time limit of the program applied to.
+   *
+   * @return testcaser::integrator::TimeLimitClock the clock
+   */
+  testcaser::integrator::TimeLimitClock get_time_limit_clock() const {
+    return limit_clock;
+  }
   /**
    * @brief Get the virtual memory used by the program in KB
    *
@@ -166,6 +289,14 @@ class Result {
    * @return size_t the used physical memory in KB
    */
   size_t get_physical_memory_used() const { return runtime_memory; }
+  /**
+   * @brief Get where the physical memory used by the program was measured.
+   *
+   * @return testcaser::integrator::MemorySource the source of the measure
+   */
+  testcaser::integrator::MemorySource get_memory_source() const {
+    return memory_source;
+  }
   /**
    * @brief Get the exit code of the program
    *
@@ -0,0 +1,52 @@
+/**
+ * Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * A judge that once used more memory than the limit, and has freed it, judges
+ * /bin/true. The peak of the judge must not be charged to the program.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <iostream>
+#include <testcaser/integrator>
+#include <vector>
+
+using std::cout;
+using std::endl;
+
+using testcaser::integrator::ExitStatus;
+using testcaser::integrator::Result;
+using testcaser::internal::executor_engine;
+
+int main() {
+  {
+    std::vector<char> memory(600UL * 1024 * 1024, 1);
+    cout << "Peak of the judge : "
+         << executor_engine::get_memory_peak(getpid()) << " KB ("
+         << static_cast<int>(memory[memory.size() / 2]) << ")" << endl;
+  }
+
+  int const input = open("/dev/null", O_RDONLY | O_CLOEXEC);
+  Result result = executor_engine::for_execution_of(
+      "/bin/true", input, "N/A", 256 * 1024, 1000, 30000, true);
+  close(input);
+  result.print_result();
+  bool const judged = result.get_exit_status() == ExitStatus::SUCCESS &&
+                      result.get_physical_memory_used() < 256 * 1024;
+  cout << "A freed peak of the judge is not charged : " << judged << endl;
+  return judged ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+/**
+ * Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Measures how many runs of a trivial program the judge completes per second,
+ * with the judge holding little memory and then a large test in memory. The
+ * launcher of the executor is compared against a plain fork and exec of the
+ * same program, whose cost grows with the memory of the judge. The program is
+ * /bin/true unless another one is given as the first argument.
+ */
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <testcaser/integrator>
+#include <vector>
+
+using std::cout;
+using std::endl;
+
+using testcaser::internal::child_launcher;
+using testcaser::internal::executor_engine;
+
+// runs the trial for about a second and counts the runs
+template <class Trial>
+double per_second(Trial trial) {
+  auto start = std::chrono::steady_clock::now();
+  auto stop = start + std::chrono::seconds(1);
+  int runs = 0;
+  for (; std::chrono::steady_clock::now() < stop; runs++) trial();
+  return runs / std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+}
+
+void forked(std::string const& program) {
+  pid_t pid = fork();
+  if (pid == 0) {
+    execl(program.c_str(), program.c_str(), (char*)0);
+    _exit(127);
+  }
+  int status;
+  waitpid(pid, &status, 0);
+}
+
+void launched(std::string const& program) {
+  child_launcher launcher(program, std::vector<std::string>(1, program));
+  launcher.set_limit(RLIMIT_CPU, 2);
+  pid_t pid = launcher.launch();
+  int status;
+  waitpid(pid, &status, 0);
+}
+
+double judged(std::string const& program, int input) {
+  // the executor reports every run on stdout
+  int const console = dup(STDOUT_FILENO);
+  int const quiet = open("/dev/null", O_WRONLY);
+  fflush(stdout);
+  dup2(quiet, STDOUT_FILENO);
+  double const rate = per_second([&] {
+    executor_engine::for_execution_of(program, input, "N/A", 256 * 1024, 1000,
+                                      30000, true);
+  });
+  fflush(stdout);
+  dup2(console, STDOUT_FILENO);
+  close(quiet);
+  close(console);
+  return rate;
+}
+
+void bench(std::string const& name, std::string const& program, int input) {
+  cout << std::left << std::setw(12) << name << std::setw(14)
+       << per_second([&] { forked(program); }) << std::setw(14)
+       << per_second([&] { launched(program); }) << std::setw(14)
+       << judged(program, input) << endl;
+}
+
+int main(int argc, char* argv[]) {
+  std::string const program = argc > 1 ? argv[1] : "/bin/true";
+  int const input = open("/dev/null", O_RDONLY | O_CLOEXEC);
+  cout << "runs per second of " << program << endl;
+  cout << std::left << std::setw(12) << "judge" << std::setw(14) << "fork"
+       << std::setw(14) << "launcher" << std::setw(14) << "executor" << endl;
+  bench("small", program, input);
+  // a judge holding a large test in memory
+  std::vector<char> test(1024UL * 1024 * 1024);
+  memset(test.data(), 1, test.size());
+  bench("1 GB", program, input);
+  close(input);
+  return test[test.size() / 2] == 1 ? 0 : 1;
+}
@@ -18,16 +18,25 @@
 #define __BUILDER_HPP__
 
 #include <stdio.h>
-#include <fstream>
+#include <algorithm>
 #include <iostream>
+#include <memory>
 #include <random>
 #include <string>
 #include <testcaser/core/exceptions/BuildException.hpp>
+#include <testcaser/core/maker/format.hpp>
+#include <testcaser/core/maker/randoms/corpus.hpp>
 #include <testcaser/core/maker/randoms/RandomTypes.hpp>
-#include <typeindex>
+#include <testcaser/core/maker/sinks.hpp>
+#include <testcaser/core/maker/writer.hpp>
+#include <type_traits>
+#include <vector>
 #ifndef _IO_BUFSIZ
 #define _IO_BUFSIZ (4096)
 #endif
+#ifndef _TESTCASER_BATCH_SIZE
+#define _TESTCASER_BATCH_SIZE (64)
+#endif
 
 
 /**
@@ -50,15 +59,193 @@ namespace maker {
  *
  */
 class TestCaseBuilder {
-  std::ofstream file;
+  std::shared_ptr<sinks::BaseSink> sink;
   bool finalized = false;
+  bool verbose = true;
   std::string fname;
-  std::string to_write;
+  std::vector<char> buffer;
+  std::unique_ptr<sinks::BackgroundWriter> writer;
+  // the memory being formatted into. It is the buffer or the memory of the
+  // sink when the sink can be written in place.
+  char* window = nullptr;
+  std::size_t capacity = 0, used = 0;
+  // the number of bytes handed to the sink so far
+  std::size_t flushed = 0;
+  bool in_place = false;
+
+  static_assert(_IO_BUFSIZ >= _TESTCASER_BATCH_SIZE *
+                                  (format::max_integral_length + 1),
+                "_IO_BUFSIZ must hold a complete batch of values");
 
-  bool buffer_full() { return _IO_BUFSIZ <= to_write.size(); }
+  /**
+   * @brief Hands the formatted bytes to the sink without making room for more.
+   * In place the window is left empty, so that a last hand off does not grow
+   * the sink.
+   *
+   */
+  void hand_off() {
+    if (in_place) {
+      sink->commit(used);
+      flushed += used;
+      used = 0;
+      window = nullptr;
+      capacity = 0;
+      return;
+    }
+    if (writer)
+      writer->submit(buffer, used);
+    else
+      sink->write(buffer.data(), used);
+    // counted once the bytes were handed off, a throw leaves them unflushed
+    flushed += used;
+    used = 0;
+    window = buffer.data();
+    capacity = buffer.size();
+  }
   void perform_write() {
-    file << to_write;
-    to_write.clear();
+    this->hand_off();
+    if (in_place) window = sink->acquire(_IO_BUFSIZ, capacity);
+  }
+  /**
+   * @brief Makes room for atleast count bytes at the end of the buffer by
+   * flushing it when required.
+   *
+   * @param count the number of bytes that will be written next
+   * @return char* the position to write those bytes at
+   */
+  char* reserve(std::size_t count) {
+    if (used + count > capacity) this->perform_write();
+    return window + used;
+  }
+  /**
+   * @brief Appends raw bytes to the buffer. Blocks bigger than _IO_BUFSIZ are
+   * written straight to the sink.
+   *
+   * @param data the bytes to write
+   * @param count the number of bytes
+   */
+  void append(char const* data, std::size_t count) {
+    if (count > _IO_BUFSIZ) {
+      this->hand_off();
+      if (writer) writer->drain();
+      sink->write(data, count);
+      flushed += count;
+      if (in_place) window = sink->acquire(_IO_BUFSIZ, capacity);
+      return;
+    }
+    std::copy(data, data + count, this->reserve(count));
+    used += count;
+  }
+  /**
+   * @brief Formats a value into the buffer without any allocation.
+   *
+   * @tparam T the type of value
+   * @param value the value to write
+   */
+  template <class T>
+  void write_value(T value, std::true_type) {
+    used += format::write(this->reserve(format::max_length<T>::value), value);
+  }
+  /**
+   * @brief Formats the types that format cannot handle through std::to_string
+   *
+   * @tparam T the type of value
+   * @param value the value to write
+   */
+  template <class T>
+  void write_value(T value, std::false_type) {
+    std::string const str = std::to_string(value);
+    this->append(str.data(), str.size());
+  }
+  /**
+   * @brief Writes the value to the buffer choosing the fastest way to format
+   * it.
+   *
+   * @tparam T the type of the value
+   * @param value the value to write
+   */
+  template <class T>
+  void write_value(T value) {
+    this->write_value(value, format::is_direct_writable<T>());
+  }
+  /**
+   * @brief Writes count values produced by filler in batches of
+   * _TESTCASER_BATCH_SIZE. Each batch is drawn with a single call to the filler
+   * and formatted in a tight loop after one buffer reservation.
+   *
+   * @tparam T the type of value produced by the filler
+   * @tparam Filler the callable filling a T* with n values
+   * @param filler the callable
+   * @param count the number of values to write
+   * @param separator the character written in between two values
+   */
+  template <class T, class Filler>
+  void write_batched(Filler const& filler, std::size_t count, char separator,
+                     std::true_type) {
+    T values[_TESTCASER_BATCH_SIZE];
+    while (count > 0) {
+      std::size_t const batch =
+          count < _TESTCASER_BATCH_SIZE ? count : _TESTCASER_BATCH_SIZE;
+      filler(values, batch);
+      count -= batch;
+      char* out = this->reserve(batch * (format::max_length<T>::value + 1));
+      for (std::size_t t = 0; t < batch; t++) {
+        out += format::write(out, values[t]);
+        *out++ = separator;
+      }
+      used = out - window;
+      // the last value of the row is not followed by a separator
+      if (count == 0) used--;
+    }
+  }
+  /**
+   * @brief Writes count values produced by filler. It is used for the types
+   * that need std::to_string to be formatted.
+   *
+   */
+  template <class T, class Filler>
+  void write_batched(Filler const& filler, std::size_t count, char separator,
+                     std::false_type) {
+    T values[_TESTCASER_BATCH_SIZE];
+    while (count > 0) {
+      std::size_t const batch =
+          count < _TESTCASER_BATCH_SIZE ? count : _TESTCASER_BATCH_SIZE;
+      filler(values, batch);
+      count -= batch;
+      for (std::size_t t = 0; t < batch; t++) {
+        this->write_value(values[t]);
+        if (count > 0 || t + 1 < batch) this->write_value(separator);
+      }
+    }
+  }
+  /**
+   * @brief Fills out with the values of a random type, in bulk when the type
+   * has a fill(..).
+   *
+   */
+  template <class Random, class T>
+  static auto fill_values(Random& random, T* out, std::size_t count, int)
+      -> decltype(random.fill(out, count), void()) {
+    random.fill(out, count);
+  }
+  template <class Random, class T>
+  static void fill_values(Random& random, T* out, std::size_t count, long) {
+    for (std::size_t t = 0; t < count; t++) out[t] = random.get();
+  }
+  /**
+   * @brief Writes a complete row of count values followed by the terminator.
+   *
+   */
+  template <class T, class Filler>
+  void write_row(Filler const& filler, std::size_t count, char separator,
+                 char terminator) {
+    if (this->finalized) {
+      throw testcaser::exceptions::maker::FinalizationError(
+          "Cannot add new values once file has been finalized");
+    }
+    this->write_batched<T>(filler, count, separator,
+                           format::is_direct_writable<T>());
+    this->write_value(terminator);
   }
 
  public:
@@ -72,216 +259,279 @@ class TestCaseBuilder {
    * @param abs_name The Absolute name of the testfile to generate. it should be
    * a txt file
    */
-  explicit TestCaseBuilder(std::string abs_name) : fname(abs_name) {
-    file.open(abs_name, std::ios::out);
-    if (!file.is_open() || !file.good()) {
+  explicit TestCaseBuilder(std::string abs_name)
+      : TestCaseBuilder(std::make_shared<sinks::FileSink>(abs_name)) {}
+  /**
+   * @brief Construct a new Test Case Builder object that writes to the sink.
+   * Keep a copy of the pointer to read the test back from sinks like
+   * sinks::MemorySink or sinks::MemfdSink once finalized.
+   *
+   * @param output The sink to write the test case to.
+   */
+  explicit TestCaseBuilder(std::shared_ptr<sinks::BaseSink> output)
+      : sink(output) {
+    if (!sink) {
       throw testcaser::exceptions::maker::TestFileIOError(
-          "File is Open : " + std::to_string(file.is_open()) +
-          " :: File is Good : " + std::to_string(file.good()));
-      to_write.reserve(_IO_BUFSIZ + 1);
+          "TestCaseBuilder was given an empty sink");
+    }
+    fname = sink->name();
+    window = sink->acquire(_IO_BUFSIZ, capacity);
+    in_place = window != nullptr;
+    if (!in_place) {
+      buffer.resize(_IO_BUFSIZ);
+      window = buffer.data();
+      capacity = buffer.size();
     }
-    file.seekp(0, std::ios::beg);
+  }
+#ifndef _WIN32
+  /**
+   * @brief Construct a new Test Case Builder object that formats straight into
+   * a memory mapped file. The file is preallocated to size_hint bytes, grown
+   * in chunks when the hint is exceeded and truncated to the real length by
+   * finalize().
+   *
+   * @param abs_name The Absolute name of the testfile to generate.
+   * @param size_hint The estimated size of the test case in bytes.
+   */
+  TestCaseBuilder(std::string abs_name, std::size_t size_hint)
+      : TestCaseBuilder(
+            std::make_shared<sinks::MappedFileSink>(abs_name, size_hint)) {}
+#endif
+  /**
+   * @brief Turns on the asynchronous mode. The builder fills a buffer of
+   * buffer_size bytes while a background thread writes the previous one to
+   * the sink, so generation and I/O overlap. finalize() waits for the thread
+   * and rethrows any error raised while writing. Sinks written in place, like
+   * sinks::MappedFileSink, have no I/O to overlap and ignore this mode.
+   *
+   * @param buffer_size the size in bytes of each of the two buffers
+   * @return TestCaseBuilder& this builder
+   */
+  TestCaseBuilder& set_async_write(std::size_t buffer_size = 1 << 22) {
+    if (this->finalized) {
+      throw testcaser::exceptions::maker::FinalizationError(
+          "Cannot change the write mode once file has been finalized");
+    }
+    if (in_place) return *this;
+    this->perform_write();
+    if (writer) writer->finish();
+    if (buffer_size < _IO_BUFSIZ) buffer_size = _IO_BUFSIZ;
+    buffer.assign(buffer_size, '\0');
+    writer.reset(new sinks::BackgroundWriter(sink, buffer_size));
+    window = buffer.data();
+    capacity = buffer.size();
+    return *this;
   }
   /**
    * @brief Adds a new RandomAlphabet to the testcase file
    *
    * @tparam std::mt19937 The Generator to use in the generation
-   * @tparam std::uniform_int_distribution<long long> The Distribution to use in
+   * @tparam distributions::BoundedInteger<long long> The Distribution to use in
    * the sampling.
    * @param randomAlphabet The RandomAlphabet type to use here.
    * @return char The Generated Random Alphabet
    */
   template <class gen = std::mt19937,
-            class dis = std::uniform_int_distribution<long long>>
+            class dis = distributions::BoundedInteger<long long>>
   char add(types::RandomAlphabet<gen, dis>& randomAlphabet) {
     if (this->finalized) {
       throw testcaser::exceptions::maker::FinalizationError(
           "Cannot add new alphabet once file has been finalized");
     }
     char u = randomAlphabet.get();
-    if (this->buffer_full()) this->perform_write();
-    to_write += std::to_string(u);
+    this->write_value(u);
     return u;
   };
   /**
    * @brief Adds a new RandomLowerAlphabet to the testcase file
    *
    * @tparam std::mt19937 The Generator to use in the generation
-   * @tparam std::uniform_int_distribution<long long> The Distribution to use in
+   * @tparam distributions::BoundedInteger<long long> The Distribution to use in
    * the sampling.
    * @param randomLowerAlphabet The RandomLowerAlphabet type to use here.
    * @return char The Generated Random Lower Alphabet
    */
   template <class gen = std::mt19937,
-            class dis = std::uniform_int_distribution<long long>>
+            class dis = distributions::BoundedInteger<long long>>
   char add(types::RandomLowerAlphabet<gen, dis>& randomLowerAlphabet) {
     if (this->finalized) {
       throw testcaser::exceptions::maker::FinalizationError(
           "Cannot add new lower alphabet once file has been finalized");
     }
     char u = randomLowerAlphabet.get();
-    if (this->buffer_full()) this->perform_write();
-    to_write += std::to_string(u);
+    this->write_value(u);
     return u;
   };
   /**
    * @brief Adds a new RandomUpperAlphabet to the testcase file
    *
    * @tparam std::mt19937 The Generator to use in the generation
-   * @tparam std::uniform_int_distribution<long long> The Distribution to use in
+   * @tparam distributions::BoundedInteger<long long> The Distribution to use in
    * the sampling.
    * @param randomUpperAlphabet The RandomUpperAlphabet type to use here.
    * @return char The Generated Random Upper Alphabet
    */
   template <class gen = std::mt19937,
-            class dis = std::uniform_int_distribution<long long>>
+            class dis = distributions::BoundedInteger<long long>>
   char add(types::RandomUpperAlphabet<gen, dis>& randomUpperAlphabet) {
     if (this->finalized) {
       throw testcaser::exceptions::maker::FinalizationError(
           "Cannot add new alphabet once file has been finalized");
     }
     char u = randomUpperAlphabet.get();
-    if (this->buffer_full()) this->perform_write();
-    to_write += std::to_string(u);
+    this->write_value(u);
     return u;
   };
   /**
    * @brief Adds a new RandomInteger to the testcase file
    *
    * @tparam std::mt19937 The Generator to use in the generation
-   * @tparam std::uniform_int_distribution<long long> The Distribution to use in
+   * @tparam distributions::BoundedInteger<long long> The Distribution to use in
    * the sampling.
    * @param randomInteger The RandomInteger type to use here.
    * @return long long The Generated Random Integer
    */
   template <class gen = std::mt19937,
-            class dis = std::uniform_int_distribution<long long>>
+            class dis = distributions::BoundedInteger<long long>>
   long long add(types::RandomInteger<gen, dis>& randomInteger) {
     if (this->finalized) {
       throw testcaser::exceptions::maker::FinalizationError(
           "Cannot add new line once file has been finalized");
     }
     long long res = randomInteger.get();
-    if (this->buffer_full()) this->perform_write();
-    to_write += std::to_string(res);
+    this->write_value(res);
+    return res;
+  };
+  /**
+   * @brief Adds a new random integer of a distribution, such as RandomNormal
+   * or RandomZipf, to the testcase file.
+   *
+   * @tparam gen The Generator to use in the generation
+   * @tparam dis The Distribution of the values
+   * @param shapedRandom The random type to use here.
+   * @return long long The Generated Random Integer
+   */
+  template <class gen, class dis>
+  long long add(types::ShapedRandom<gen, dis>& shapedRandom) {
+    if (this->finalized) {
+      throw testcaser::exceptions::maker::FinalizationError(
+          "Cannot add new line once file has been finalized");
+    }
+    long long res = shapedRandom.get();
+    this->write_value(res);
     return res;
   };
   /**
    * @brief Adds a new RandomBinary to the testcase file.
    *
    * @tparam std::mt19937 The Generator to use in the generation
-   * @tparam std::uniform_int_distribution<unsigned long long> The Distribution
+   * @tparam distributions::BoundedInteger<unsigned long long> The Distribution
    * to use in the sampling.
    * @param randomBinary The RandomBinary type to use here.
    * @return unsigned long long The Generated Random Binary
    */
   template <class gen = std::mt19937,
-            class dis = std::uniform_int_distribution<unsigned long long>>
+            class dis = distributions::BoundedInteger<unsigned long long>>
   unsigned long long add(types::RandomBinary<gen, dis>& randomBinary) {
     if (this->finalized) {
       throw testcaser::exceptions::maker::FinalizationError(
           "Cannot add new binary line once file has been finalized");
     }
     unsigned long long res = randomBinary.get_as_int();
-    if (this->buffer_full()) this->perform_write();
-    to_write += std::to_string(res);
+    this->write_value(res);
     return res;
   };
   /**
    * @brief Adds a new RandomTernary to the testcase file.
    *
    * @tparam std::mt19937 The Generator to use in the generation
-   * @tparam std::uniform_int_distribution<unsigned long long> The Distribution
+   * @tparam distributions::BoundedInteger<unsigned long long> The Distribution
    * to use in the sampling.
    * @param randomTernary The RandomTernary type to use here.
    * @return unsigned long long The Generated Random Ternary
    */
   template <class gen = std::mt19937,
-            class dis = std::uniform_int_distribution<unsigned long long>>
+            class dis = distributions::BoundedInteger<unsigned long long>>
   unsigned long long add(types::RandomTernary<gen, dis>& randomTernary) {
     if (this->finalized) {
       throw testcaser::exceptions::maker::FinalizationError(
           "Cannot add new ternary line once file has been finalized");
     }
     unsigned long long res = randomTernary.get_as_int();
-    if (this->buffer_full()) this->perform_write();
-    to_write += std::to_string(res);
+    this->write_value(res);
     return res;
   };
   /**
    * @brief Adds a new RandomQuaternary to the testcase file.
    *
    * @tparam std::mt19937 The Generator to use in the generation
-   * @tparam std::uniform_int_distribution<unsigned long long> The Distribution
+   * @tparam distributions::BoundedInteger<unsigned long long> The Distribution
    * to use in the sampling.
    * @param randomQuaternary The RandomQuaternary type to use here.
    * @return unsigned long long The Generated Random Quaternary
    */
   template <class gen = std::mt19937,
-            class dis = std::uniform_int_distribution<unsigned long long>>
+            class dis = distributions::BoundedInteger<unsigned long long>>
   unsigned long long add(types::RandomQuaternary<gen, dis>& randomQuaternary) {
     if (this->finalized) {
       throw testcaser::exceptions::maker::FinalizationError(
           "Cannot add new binary quaternary once file has been finalized");
     }
     unsigned long long res = randomQuaternary.get_as_int();
-    if (this->buffer_full()) this->perform_write();
-    to_write += std::to_string(res);
+    this->write_value(res);
     return res;
   };
   /**
    * @brief Adds a new RandomQuinary to the testcase file.
    *
    * @tparam std::mt19937 The Generator to use in the generation
-   * @tparam std::uniform_int_distribution<unsigned long long> The Distribution
+   * @tparam distributions::BoundedInteger<unsigned long long> The Distribution
    * to use in the sampling.
    * @param randomQuinary The RandomQuinary type to use here.
    * @return unsigned long long The Generated Random Quinary
    */
   template <class gen = std::mt19937,
-            class dis = std::uniform_int_distribution<unsigned long long>>
+            class dis = distributions::BoundedInteger<unsigned long long>>
   unsigned long long add(types::RandomQuinary<gen, dis>& randomQuinary) {
     if (this->finalized) {
       throw testcaser::exceptions::maker::FinalizationError(
           "Cannot add new quinary line once file has been finalized");
     }
     unsigned long long res = randomQuinary.get_as_int();
-    if (this->buffer_full()) this->perform_write();
-    to_write += std::to_string(res);
+    this->write_value(res);
     return res;
   };
   /**
    * @brief Adds a new RandomSenary to the testcase file.
    *
    * @tparam std::mt19937 The Generator to use in the generation
-   * @tparam std::uniform_int_distribution<unsigned long long> The Distribution
+   * @tparam distributions::BoundedInteger<unsigned long long> The Distribution
    * to use in the sampling.
    * @param randomSenary The RandomSenary type to use here.
    * @return unsigned long long The Generated Random Senary
    */
   template <class gen = std::mt19937,
-            class dis = std::uniform_int_distribution<unsigned long long>>
+            class dis = distributions::BoundedInteger<unsigned long long>>
   unsigned long long add(types::RandomSenary<gen, dis>& randomSenary) {
     if (this->finalized) {
       throw testcaser::exceptions::maker::FinalizationError(
           "Cannot add new senary line once file has been finalized");
     }
     unsigned long long res = randomSenary.get_as_int();
-    if (this->buffer_full()) this->perform_write();
-    to_write += std::to_string(res);
+    this->write_value(res);
     return res;
   };
   /**
    * @brief Adds a new RandomUnsignedInteger to the testcase file.
    *
    * @tparam std::mt19937 The Generator to use in the generation
-   * @tparam std::uniform_int_distribution<unsigned long long> The Distribution
+   * @tparam distributions::BoundedInteger<unsigned long long> The Distribution
    * to use in the sampling.
    * @param randomUnsignedInteger The RandomUnsigned type to use here.
    * @return unsigned long long The Generated Random Unsigned
    */
   template <class gen = std::mt19937,
-            class dis = std::uniform_int_distribution<unsigned long long>>
+            class dis = distributions::BoundedInteger<unsigned long long>>
   unsigned long long add(
       types::RandomUnsignedInteger<gen, dis>& randomUnsignedInteger) {
     if (this->finalized) {
@@ -289,8 +539,7 @@ class TestCaseBuilder {
           "Cannot add new unsigned long long once file has been finalized");
     }
     unsigned long long res = randomUnsignedInteger.get();
-    if (this->buffer_full()) this->perform_write();
-    to_write += std::to_string(res);
+    this->write_value(res);
     return res;
   };
   /**
@@ -298,35 +547,162 @@ class TestCaseBuilder {
    *
    * @tparam T The type of the collection to sample from.
    * @tparam std::mt19937 The Generator to use in the generation
-   * @tparam std::uniform_int_distribution<unsigned long long> The Distribution
+   * @tparam distributions::BoundedInteger<unsigned long long> The Distribution
    * to use in the sampling.
    * @param randomFrom The object of RandomFrom to use
    * @return T The Randomly Sampled value.
    */
   template <class T, class gen = std::mt19937,
-            class dis = std::uniform_int_distribution<unsigned long long>>
+            class dis = distributions::BoundedInteger<unsigned long long>>
   T add(types::RandomFrom<T, gen, dis>& randomFrom) {
     if (this->finalized) {
       throw testcaser::exceptions::maker::FinalizationError(
           "Cannot add new randomFrom once file has been finalized");
     }
     auto res = randomFrom.get();
-    if (this->buffer_full()) this->perform_write();
-    if (typeid(T) == typeid(char)) {
-      char buf[2];
-      buf[0] = res;
-      buf[1] = '\0';
-      to_write.append(buf);
-    } else
-      to_write += std::to_string(res);
+    this->write_value(res);
+    return res;
+  };
+  /**
+   * @brief Adds a new RandomFromView to the testcase file.
+   *
+   * @tparam T The type of the collection to sample from.
+   * @tparam std::mt19937 The Generator to use in the generation
+   * @tparam distributions::BoundedInteger<unsigned long long> The Distribution
+   * to use in the sampling.
+   * @param randomFromView The object of RandomFromView to use
+   * @return T The Randomly Sampled value.
+   */
+  template <class T, class gen = std::mt19937,
+            class dis = distributions::BoundedInteger<unsigned long long>>
+  T add(types::RandomFromView<T, gen, dis>& randomFromView) {
+    if (this->finalized) {
+      throw testcaser::exceptions::maker::FinalizationError(
+          "Cannot add new randomFromView once file has been finalized");
+    }
+    T const& res = randomFromView.get();
+    this->write_value(res);
     return res;
   };
+  /**
+   * @brief Adds count randomly picked objects of RandomFromView to the file in
+   * one call. The objects are written separated by separator and the row is
+   * ended by the terminator.
+   *
+   * @param randomFromView The object of RandomFromView to use
+   * @param count the number of values to write
+   * @param separator the character in between two values
+   * @param terminator the character written after the last value
+   */
+  template <class T, class gen = std::mt19937,
+            class dis = distributions::BoundedInteger<unsigned long long>>
+  void add_n(types::RandomFromView<T, gen, dis>& randomFromView,
+             std::size_t count, char separator = ' ', char terminator = '\n') {
+    this->write_row<T>(
+        [&randomFromView](T* out, std::size_t n) {
+          randomFromView.fill(out, n);
+        },
+        count, separator, terminator);
+  }
+  /**
+   * @brief Adds a new RandomToken to the testcase file. The characters of the
+   * token are copied straight from the corpus.
+   *
+   * @tparam std::mt19937 The Generator to use in the generation
+   * @tparam distributions::BoundedInteger<unsigned long long> The Distribution
+   * to use in the sampling.
+   * @param randomToken The object of RandomToken to use
+   * @return Token The Randomly picked token.
+   */
+  template <class gen = std::mt19937,
+            class dis = distributions::BoundedInteger<unsigned long long>>
+  Token add(types::RandomToken<gen, dis>& randomToken) {
+    if (this->finalized) {
+      throw testcaser::exceptions::maker::FinalizationError(
+          "Cannot add new token once file has been finalized");
+    }
+    Token const res = randomToken.get();
+    this->append(res.text, res.length);
+    return res;
+  };
+  /**
+   * @brief Adds count randomly picked tokens to the file in one call. The
+   * tokens are written separated by separator and the row is ended by the
+   * terminator.
+   *
+   * @param randomToken The object of RandomToken to use
+   * @param count the number of tokens to write
+   * @param separator the character in between two tokens
+   * @param terminator the character written after the last token
+   */
+  template <class gen = std::mt19937,
+            class dis = distributions::BoundedInteger<unsigned long long>>
+  void add_n(types::RandomToken<gen, dis>& randomToken, std::size_t count,
+             char separator = ' ', char terminator = '\n') {
+    if (this->finalized) {
+      throw testcaser::exceptions::maker::FinalizationError(
+          "Cannot add new tokens once file has been finalized");
+    }
+    Token tokens[_TESTCASER_BATCH_SIZE];
+    while (count > 0) {
+      std::size_t const batch =
+          count < _TESTCASER_BATCH_SIZE ? count : _TESTCASER_BATCH_SIZE;
+      randomToken.fill(tokens, batch);
+      count -= batch;
+      for (std::size_t t = 0; t < batch; t++) {
+        this->append(tokens[t].text, tokens[t].length);
+        if (count > 0 || t + 1 < batch) this->write_value(separator);
+      }
+    }
+    this->write_value(terminator);
+  }
+  /**
+   * @brief Adds a new RandomWeightedFrom to the testcase file.
+   *
+   * @tparam T The type of the collection to sample from.
+   * @tparam std::mt19937 The Generator to use in the generation
+   * @tparam distributions::BoundedInteger<unsigned long long> The Distribution
+   * to use in the sampling.
+   * @param randomWeightedFrom The object of RandomWeightedFrom to use
+   * @return T The Randomly Sampled value.
+   */
+  template <class T, class gen = std::mt19937,
+            class dis = distributions::BoundedInteger<unsigned long long>>
+  T add(types::RandomWeightedFrom<T, gen, dis>& randomWeightedFrom) {
+    if (this->finalized) {
+      throw testcaser::exceptions::maker::FinalizationError(
+          "Cannot add new randomWeightedFrom once file has been finalized");
+    }
+    auto res = randomWeightedFrom.get();
+    this->write_value(res);
+    return res;
+  };
+  /**
+   * @brief Adds count objects picked by RandomWeightedFrom to the file in one
+   * call. The objects are written separated by separator and the row is ended
+   * by the terminator.
+   *
+   * @param randomWeightedFrom The object of RandomWeightedFrom to use
+   * @param count the number of values to write
+   * @param separator the character in between two values
+   * @param terminator the character written after the last value
+   */
+  template <class T, class gen = std::mt19937,
+            class dis = distributions::BoundedInteger<unsigned long long>>
+  void add_n(types::RandomWeightedFrom<T, gen, dis>& randomWeightedFrom,
+             std::size_t count, char separator = ' ', char terminator = '\n') {
+    this->write_row<T>(
+        [&randomWeightedFrom](T* out, std::size_t n) {
+          randomWeightedFrom.fill(out, n);
+        },
+        count, separator, terminator);
+  }
 
   /**
    * @brief Adds a new Random Integer which will be more than value specified
    *
    * @tparam std::mt19937 The Random Number Generator
-   * @tparam std::uniform_int_distribution<long long> The Uniform Sampler for
+   * @tparam distributions::BoundedInteger<long long> The Uniform Sampler for
    * Sampling the Numbers.
    * @param val The value of restriction. Output will be more than this value
    * always.
@@ -335,12 +711,11 @@ class TestCaseBuilder {
    */
 
   template <class gen = std::mt19937,
-            class dis = std::uniform_int_distribution<long long>>
+            class dis = distributions::BoundedInteger<long long>>
   long long add_more_than(long long val,
                           types::RandomInteger<gen, dis>& randomInteger) {
     auto res = randomInteger.get_more_than(val);
-    if (this->buffer_full()) this->perform_write();
-    to_write += std::to_string(res);
+    this->write_value(res);
     return res;
   }
   /**
@@ -348,7 +723,7 @@ class TestCaseBuilder {
    * specified
    *
    * @tparam std::mt19937 The Random Number Generator
-   * @tparam std::uniform_int_distribution<long long> The Uniform Sampler for
+   * @tparam distributions::BoundedInteger<long long> The Uniform Sampler for
    * Sampling the Numbers.
    * @param val The value of restriction. Output will be more than this value
    * always.
@@ -358,20 +733,19 @@ class TestCaseBuilder {
    */
 
   template <class gen = std::mt19937,
-            class dis = std::uniform_int_distribution<unsigned long long>>
+            class dis = distributions::BoundedInteger<unsigned long long>>
   unsigned long long add_more_than(
       unsigned long long val,
       types::RandomUnsignedInteger<gen, dis>& randomUnsignedInteger) {
     auto res = randomUnsignedInteger.get_more_than(val);
-    if (this->buffer_full()) this->perform_write();
-    to_write += std::to_string(res);
+    this->write_value(res);
     return res;
   }
   /**
    * @brief Adds a new Random Integer which will be less than value specified
    *
    * @tparam std::mt19937 The Random Number Generator
-   * @tparam std::uniform_int_distribution<long long> The Uniform Sampler for
+   * @tparam distributions::BoundedInteger<long long> The Uniform Sampler for
    * Sampling the Numbers.
    * @param val The value of restriction. Output will be less than this value
    * always.
@@ -380,12 +754,11 @@ class TestCaseBuilder {
    */
 
   template <class gen = std::mt19937,
-            class dis = std::uniform_int_distribution<long long>>
+            class dis = distributions::BoundedInteger<long long>>
   long long add_less_than(long long val,
                           types::RandomInteger<gen, dis>& randomInteger) {
     auto res = randomInteger.get_less_than(val);
-    if (this->buffer_full()) this->perform_write();
-    to_write += std::to_string(res);
+    this->write_value(res);
     return res;
   }
   /**
@@ -393,7 +766,7 @@ class TestCaseBuilder {
    * specified
    *
    * @tparam std::mt19937 The Random Number Generator
-   * @tparam std::uniform_int_distribution<long long> The Uniform Sampler for
+   * @tparam distributions::BoundedInteger<long long> The Uniform Sampler for
    * Sampling the Numbers.
    * @param val The value of restriction. Output will be less than this value
    * always.
@@ -403,15 +776,166 @@ class TestCaseBuilder {
    */
 
   template <class gen = std::mt19937,
-            class dis = std::uniform_int_distribution<unsigned long long>>
+            class dis = distributions::BoundedInteger<unsigned long long>>
   unsigned long long add_less_than(
       unsigned long long val,
       types::RandomUnsignedInteger<gen, dis>& randomUnsignedInteger) {
     auto res = randomUnsignedInteger.get_less_than(val);
-    if (this->buffer_full()) this->perform_write();
-    to_write += std::to_string(res);
+    this->write_value(res);
     return res;
   }
+  /**
+   * @brief Adds count RandomIntegers to the file in one call. The values are
+   * drawn in batches and written separated by separator and the row is ended
+   * by the terminator.
+   *
+   * @tparam std::mt19937 The Generator to use in the generation
+   * @tparam distributions::BoundedInteger<long long> The Distribution to use in
+   * the sampling.
+   * @param randomInteger The RandomInteger type to use here.
+   * @param count the number of values to write
+   * @param separator the character in between two values
+   * @param terminator the character written after the last value
+   */
+  template <class gen = std::mt19937,
+            class dis = distributions::BoundedInteger<long long>>
+  void add_n(types::RandomInteger<gen, dis>& randomInteger, std::size_t count,
+             char separator = ' ', char terminator = '\n') {
+    this->write_row<long long>(
+        [&randomInteger](long long* out, std::size_t n) {
+          randomInteger.fill(out, n);
+        },
+        count, separator, terminator);
+  }
+  /**
+   * @brief Adds count RandomUnsignedIntegers to the file in one call. The
+   * values are drawn in batches and written separated by separator and the row
+   * is ended by the terminator.
+   *
+   * @tparam std::mt19937 The Generator to use in the generation
+   * @tparam distributions::BoundedInteger<unsigned long long> The Distribution
+   * to use in the sampling.
+   * @param randomUnsignedInteger The RandomUnsignedInteger type to use here.
+   * @param count the number of values to write
+   * @param separator the character in between two values
+   * @param terminator the character written after the last value
+   */
+  template <class gen = std::mt19937,
+            class dis = distributions::BoundedInteger<unsigned long long>>
+  void add_n(types::RandomUnsignedInteger<gen, dis>& randomUnsignedInteger,
+             std::size_t count, char separator = ' ', char terminator = '\n') {
+    this->write_row<unsigned long long>(
+        [&randomUnsignedInteger](unsigned long long* out, std::size_t n) {
+          randomUnsignedInteger.fill(out, n);
+        },
+        count, separator, terminator);
+  }
+  /**
+   * @brief Adds count randomly picked objects of RandomFrom to the file in one
+   * call. The objects are written separated by separator and the row is ended
+   * by the terminator.
+   *
+   * @tparam T The type of the collection to sample from.
+   * @tparam std::mt19937 The Generator to use in the generation
+   * @tparam distributions::BoundedInteger<unsigned long long> The Distribution
+   * to use in the sampling.
+   * @param randomFrom The object of RandomFrom to use
+   * @param count the number of values to write
+   * @param separator the character in between two values
+   * @param terminator the character written after the last value
+   */
+  template <class T, class gen = std::mt19937,
+            class dis = distributions::BoundedInteger<unsigned long long>>
+  void add_n(types::RandomFrom<T, gen, dis>& randomFrom, std::size_t count,
+             char separator = ' ', char terminator = '\n') {
+    this->write_row<T>(
+        [&randomFrom](T* out, std::size_t n) { randomFrom.fill(out, n); },
+        count, separator, terminator);
+  }
+  /**
+   * @brief Adds count values of any random type having a get() method such as
+   * RandomAlphabet. The types having a fill(..) of their values, such as
+   * RandomNormal, are drawn in batches.
+   *
+   * @tparam Random the random type
+   * @param random the random object to draw values from
+   * @param count the number of values to write
+   * @param separator the character in between two values
+   * @param terminator the character written after the last value
+   */
+  template <class Random>
+  void add_n(Random& random, std::size_t count, char separator = ' ',
+             char terminator = '\n') {
+    typedef typename std::decay<decltype(random.get())>::type value_type;
+    this->write_row<value_type>(
+        [&random](value_type* out, std::size_t n) {
+          TestCaseBuilder::fill_values(random, out, n, 0);
+        },
+        count, separator, terminator);
+  }
+  /**
+   * @brief Adds an array in the most common input format. The count is written
+   * on its own line followed by a line of count random values.
+   *
+   * @tparam Random the random type to use for the elements
+   * @param random the random object to draw values from
+   * @param count the size of the array
+   * @param separator the character in between two elements
+   * @return std::size_t the size of the array written
+   */
+  template <class Random>
+  std::size_t add_array(Random& random, std::size_t count,
+                        char separator = ' ') {
+    if (this->finalized) {
+      throw testcaser::exceptions::maker::FinalizationError(
+          "Cannot add new array once file has been finalized");
+    }
+    this->write_value(count);
+    this->write_value('\n');
+    this->add_n(random, count, separator, '\n');
+    return count;
+  }
+  /**
+   * @brief Adds a row of count digits of a radix type such as RandomBinary,
+   * without separators, ended by the terminator. The digits are extracted in
+   * bulk from the engine and written straight into the buffer as characters.
+   *
+   * @tparam Radix the radix type, one of RandomBinary ... RandomSenary
+   * @param radix the radix object to draw the digits from
+   * @param count the number of digits to write
+   * @param terminator the character written after the last digit
+   * @return std::size_t the number of digits written
+   */
+  template <class Radix>
+  std::size_t add_digits(Radix& radix, std::size_t count,
+                         char terminator = '\n') {
+    if (this->finalized) {
+      throw testcaser::exceptions::maker::FinalizationError(
+          "Cannot add new digits once file has been finalized");
+    }
+    for (std::size_t left = count; left > 0;) {
+      std::size_t const batch = left < _IO_BUFSIZ ? left : _IO_BUFSIZ;
+      radix.fill_digits(this->reserve(batch), batch);
+      used += batch;
+      left -= batch;
+    }
+    this->write_value(terminator);
+    return count;
+  }
+  /**
+   * @brief Adds text to the file as it is.
+   *
+   * @param text the text to write
+   * @return std::size_t the number of bytes written
+   */
+  std::size_t add_raw(std::string const& text) {
+    if (this->finalized) {
+      throw testcaser::exceptions::maker::FinalizationError(
+          "Cannot add text once file has been finalized");
+    }
+    this->append(text.data(), text.size());
+    return text.size();
+  }
   /**
    * @brief Adds a Single Space to the file.
    *
@@ -422,8 +946,7 @@ class TestCaseBuilder {
       throw testcaser::exceptions::maker::FinalizationError(
           "Cannot add space once file has been finalized");
     }
-    if (this->buffer_full()) this->perform_write();
-    to_write.append(" ");
+    this->write_value(' ');
     return ' ';
   };
   /**
@@ -437,11 +960,7 @@ class TestCaseBuilder {
       throw testcaser::exceptions::maker::FinalizationError(
           "Cannot add special character once file has been finalized");
     }
-    if (this->buffer_full()) this->perform_write();
-    char buf[2];
-    buf[0] = chr;
-    buf[1] = '\n';
-    to_write.append(buf);
+    this->write_value(chr);
     return chr;
   };
   /**
@@ -454,8 +973,7 @@ class TestCaseBuilder {
       throw testcaser::exceptions::maker::FinalizationError(
           "Cannot add new line once file has been finalized");
     }
-    if (this->buffer_full()) this->perform_write();
-    to_write.append("\n");
+    this->write_value('\n');
     return '\n';
   }
   /**
@@ -464,24 +982,49 @@ class TestCaseBuilder {
    * modification.
    */
   void finalize() {
-    this->perform_write();
+    this->hand_off();
+    if (writer) {
+      // a failed write leaves the builder unfinalized so that it is discarded
+      std::unique_ptr<sinks::BackgroundWriter> done(std::move(writer));
+      done->finish();
+    }
     this->finalized = true;
-    std::cout << "\nWritten " << this->fname << " successfully.\n";
-    file.close();
+    if (verbose)
+      std::cout << "\nWritten " << this->fname << " successfully.\n";
+    sink->close();
+  }
+  /**
+   * @brief Turns the message printed by finalize() on or off.
+   *
+   * @param print should finalize() print where the file was written
+   * @return TestCaseBuilder& this builder
+   */
+  TestCaseBuilder& set_verbose(bool print) {
+    verbose = print;
+    return *this;
   }
+  /**
+   * @brief The number of bytes added to the test so far, including the ones
+   * still in the buffer.
+   *
+   * @return std::size_t the length of the test
+   */
+  std::size_t bytes_written() const { return flushed + used; }
+  /**
+   * @brief Get the sink this builder writes to.
+   *
+   * @return std::shared_ptr<sinks::BaseSink> the sink
+   */
+  std::shared_ptr<sinks::BaseSink> get_sink() const { return sink; }
   /**
    * @brief Destroy the Test Case Builder object. If builder was not finalized
-   * this also destroys the old existing file.
+   * this also destroys the old existing file, or whatever the sink has
+   * written so far.
    *
    */
   virtual ~TestCaseBuilder() {
-    if (this->file.is_open()) this->file.close();
-    if (!this->finalized) {
-      std::cerr << "Warning : Removing the unfinalized file " + fname + "\n";
-      if (std::remove(this->fname.c_str()) != 0) {
-        std::cerr << "Failed to remove Unfinalized file " << fname;
-      };
-    }
+    writer.reset();
+    if (!this->finalized) sink->discard();
   }
 };
 }  // namespace maker
@@ -0,0 +1,196 @@
+/**
+ *   Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef FORMAT_HPP
+#define FORMAT_HPP
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+
+namespace testcaser {
+namespace maker {
+/**
+ * @brief Internal namespace that holds the allocation free formatting routines
+ * used by the TestCaseBuilder to write values directly into its buffer.
+ *
+ */
+namespace format {
+/**
+ * @brief The maximum number of bytes any integral value can take when written
+ * by this namespace. 20 digits of an unsigned long long or 19 digits and a
+ * sign of a long long.
+ *
+ */
+static const std::size_t max_integral_length = 20;
+
+/**
+ * @brief Returns the table of all the two digit pairs from "00" to "99". The
+ * digits of the n-th pair start at index 2 * n.
+ *
+ * @return char const* the pointer to the table
+ */
+inline char const* digit_pairs() {
+  static char const table[201] =
+      "00010203040506070809"
+      "10111213141516171819"
+      "20212223242526272829"
+      "30313233343536373839"
+      "40414243444546474849"
+      "50515253545556575859"
+      "60616263646566676869"
+      "70717273747576777879"
+      "80818283848586878889"
+      "90919293949596979899";
+  return table;
+}
+
+/**
+ * @brief Counts the number of decimal digits needed to write the value
+ *
+ * @param value the value to count digits of
+ * @return unsigned the digit count, 1 for zero
+ */
+inline unsigned digit_count(unsigned long long value) {
+  unsigned count = 1;
+  for (;;) {
+    if (value < 10ull) return count;
+    if (value < 100ull) return count + 1;
+    if (value < 1000ull) return count + 2;
+    if (value < 10000ull) return count + 3;
+    value /= 10000ull;
+    count += 4;
+  }
+}
+
+/**
+ * @brief Writes the decimal representation of the value to the output. The
+ * output must have atleast max_integral_length bytes available. No null
+ * terminator is written.
+ *
+ * @param out the pointer to write the digits at
+ * @param value the value to write
+ * @return std::size_t the number of bytes written
+ */
+inline std::size_t write_unsigned(char* out, unsigned long long value) {
+  unsigned const length = digit_count(value);
+  char const* pairs = digit_pairs();
+  char* pos = out + length;
+  while (value >= 100ull) {
+    unsigned const idx = static_cast<unsigned>(value % 100ull) * 2;
+    value /= 100ull;
+    *--pos = pairs[idx + 1];
+    *--pos = pairs[idx];
+  }
+  if (value >= 10ull) {
+    unsigned const idx = static_cast<unsigned>(value) * 2;
+    *--pos = pairs[idx + 1];
+    *--pos = pairs[idx];
+  } else {
+    *--pos = static_cast<char>('0' + value);
+  }
+  return length;
+}
+
+/**
+ * @brief Writes the decimal representation of the signed value to the output.
+ * The output must have atleast max_integral_length bytes available.
+ *
+ * @param out the pointer to write the digits at
+ * @param value the value to write
+ * @return std::size_t the number of bytes written
+ */
+inline std::size_t write_signed(char* out, long long value) {
+  if (value >= 0)
+    return write_unsigned(out, static_cast<unsigned long long>(value));
+  *out = '-';
+  // negate in unsigned arithmetic so that LLONG_MIN does not overflow
+  return 1 + write_unsigned(out + 1,
+                            0ull - static_cast<unsigned long long>(value));
+}
+
+/**
+ * @brief Writes a value of any type to the output. Integral values are written
+ * as decimals with write_signed and write_unsigned, char is written as the
+ * character itself.
+ *
+ * @param out the pointer to write at
+ * @param value the value to write
+ * @return std::size_t the number of bytes written
+ */
+inline std::size_t write(char* out, char value) {
+  *out = value;
+  return 1;
+}
+/**
+ * @brief Writes a signed integral value as a decimal.
+ *
+ * @tparam T the signed integral type
+ * @param out the pointer to write at
+ * @param value the value to write
+ * @return std::size_t the number of bytes written
+ */
+template <class T>
+inline typename std::enable_if<std::is_integral<T>::value &&
+                                   std::is_signed<T>::value,
+                               std::size_t>::type
+write(char* out, T value) {
+  return write_signed(out, static_cast<long long>(value));
+}
+/**
+ * @brief Writes a unsigned integral value as a decimal.
+ *
+ * @tparam T the unsigned integral type
+ * @param out the pointer to write at
+ * @param value the value to write
+ * @return std::size_t the number of bytes written
+ */
+template <class T>
+inline typename std::enable_if<std::is_integral<T>::value &&
+                                   std::is_unsigned<T>::value,
+                               std::size_t>::type
+write(char* out, T value) {
+  return write_unsigned(out, static_cast<unsigned long long>(value));
+}
+
+/**
+ * @brief Tells how many bytes write(..) needs at most for a value of type T. It
+ * is only defined for the types that write(..) can format without allocation.
+ *
+ * @tparam T the type of value to write
+ */
+template <class T>
+struct max_length {
+  /**
+   * @brief value the maximum bytes needed
+   *
+   */
+  static const std::size_t value =
+      std::is_same<T, char>::value ? 1 : max_integral_length;
+};
+
+/**
+ * @brief Tells if write(..) can format the type T without any allocation. The
+ * other arithmetic types (float, double) still go through std::to_string.
+ *
+ * @tparam T the type to check
+ */
+template <class T>
+struct is_direct_writable : std::is_integral<T> {};
+}  // namespace format
+}  // namespace maker
+}  // namespace testcaser
+#endif
@@ -0,0 +1,219 @@
+/**
+ *   Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef POOL_HPP
+#define POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace testcaser {
+namespace maker {
+/**
+ * @brief A pool of threads where every thread has its own queue of tasks.
+ * Tasks are spread over the queues in turn, and a task submitted by a task
+ * goes to the queue of its thread. A thread runs the newest task of its own
+ * queue and steals the oldest task of another queue once its own is empty, so
+ * that a few long tasks do not leave the other threads idle. A thread with no
+ * task sleeps on its own queue and is woken by a task for its queue, or for a
+ * queue whose thread is busy. Tasks pass through no lock shared by all the
+ * threads.
+ *
+ */
+class WorkStealingPool {
+  struct Queue {
+    std::mutex lock;
+    std::condition_variable wake;
+    std::deque<std::function<void()>> tasks;
+    std::atomic<bool> sleeping{false};
+    bool signalled = false;
+  };
+  std::vector<std::unique_ptr<Queue>> queues;
+  std::vector<std::thread> workers;
+  // queued counts the tasks in the queues, pending also counts the running ones
+  std::atomic<std::size_t> queued{0}, pending{0}, turn{0};
+  std::atomic<bool> stopping{false};
+  std::exception_ptr error;
+  // guards error and the waits for the pending tasks
+  std::mutex lock;
+  std::condition_variable drained;
+
+  /**
+   * @brief The pool and the queue of the calling thread when it is a thread of
+   * a pool.
+   *
+   */
+  static std::pair<WorkStealingPool*, std::size_t>& current() {
+    static thread_local std::pair<WorkStealingPool*, std::size_t> worker(
+        nullptr, 0);
+    return worker;
+  }
+  /**
+   * @brief Takes a task from the own queue of the thread or steals one.
+   *
+   * @param own the index of the queue of the thread
+   * @param task set to the task taken
+   * @return bool if a task was taken
+   */
+  bool take(std::size_t own, std::function<void()>& task) {
+    for (std::size_t t = 0; t < queues.size(); t++) {
+      Queue& queue = *queues[(own + t) % queues.size()];
+      std::lock_guard<std::mutex> guard(queue.lock);
+      if (queue.tasks.empty()) continue;
+      if (t == 0) {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+      } else {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+      }
+      queued--;
+      return true;
+    }
+    return false;
+  }
+  void signal(Queue& queue) {
+    std::lock_guard<std::mutex> guard(queue.lock);
+    queue.signalled = true;
+    queue.wake.notify_one();
+  }
+  /**
+   * @brief Wakes the thread of the queue the task went to, or else another
+   * sleeping thread to steal it.
+   *
+   */
+  void wake_for(std::size_t target) {
+    for (std::size_t t = 0; t < queues.size(); t++) {
+      Queue& queue = *queues[(target + t) % queues.size()];
+      if (queue.sleeping) {
+        this->signal(queue);
+        return;
+      }
+    }
+  }
+  void run(std::size_t own) {
+    current() = std::make_pair(this, own);
+    Queue& mine = *queues[own];
+    for (;;) {
+      std::function<void()> task;
+      if (this->take(own, task)) {
+        std::exception_ptr failure;
+        try {
+          task();
+        } catch (...) {
+          failure = std::current_exception();
+        }
+        if (failure) {
+          std::lock_guard<std::mutex> guard(lock);
+          if (!error) error = failure;
+        }
+        if (--pending == 0) {
+          std::lock_guard<std::mutex> guard(lock);
+          drained.notify_all();
+        }
+        continue;
+      }
+      if (stopping && queued == 0) return;
+      std::unique_lock<std::mutex> guard(mine.lock);
+      mine.sleeping = true;
+      // a task submitted before sleeping was set is seen here, one submitted
+      // after it finds this thread sleeping and signals it
+      if (queued == 0 && !stopping)
+        mine.wake.wait(guard, [&] {
+          return mine.signalled || !mine.tasks.empty() || stopping;
+        });
+      mine.sleeping = false;
+      mine.signalled = false;
+    }
+  }
+
+ public:
+  WorkStealingPool(WorkStealingPool const&) = delete;
+  WorkStealingPool& operator=(WorkStealingPool const&) = delete;
+  /**
+   * @brief Construct a new Work Stealing Pool object and starts its threads.
+   *
+   * @param threads the number of threads, 0 for one per core
+   */
+  explicit WorkStealingPool(unsigned threads = 0) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    for (unsigned t = 0; t < threads; t++)
+      queues.emplace_back(new Queue());
+    for (unsigned t = 0; t < threads; t++)
+      workers.emplace_back(&WorkStealingPool::run, this, t);
+  }
+  /**
+   * @brief The number of threads of the pool.
+   *
+   * @return std::size_t the number of threads
+   */
+  std::size_t size() const { return workers.size(); }
+  /**
+   * @brief Queues a task to be run by one of the threads. A task submitted by
+   * a task of this pool goes to the queue of its thread.
+   *
+   * @param task the task to run
+   */
+  void submit(std::function<void()> task) {
+    std::size_t const target = current().first == this
+                                   ? current().second
+                                   : turn++ % queues.size();
+    pending++;
+    {
+      std::lock_guard<std::mutex> guard(queues[target]->lock);
+      queues[target]->tasks.push_back(std::move(task));
+    }
+    queued++;
+    this->wake_for(target);
+  }
+  /**
+   * @brief Waits until all the submitted tasks have run. Rethrows the first
+   * exception thrown by a task since the last wait().
+   *
+   */
+  void wait() {
+    std::unique_lock<std::mutex> guard(lock);
+    drained.wait(guard, [this] { return pending == 0; });
+    if (error) {
+      std::exception_ptr failure = error;
+      error = nullptr;
+      std::rethrow_exception(failure);
+    }
+  }
+  /**
+   * @brief Destroy the Work Stealing Pool object. The queued tasks are still
+   * run.
+   *
+   */
+  ~WorkStealingPool() {
+    stopping = true;
+    for (auto& queue : queues) this->signal(*queue);
+    for (auto& worker : workers) worker.join();
+  }
+};
+}  // namespace maker
+}  // namespace testcaser
+#endif
@@ -16,9 +16,17 @@
 #ifndef RANDOM_TYPES_HPP
 #define RANDOM_TYPES_HPP
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <random>
+#include <testcaser/core/maker/randoms/distributions.hpp>
 #include <testcaser/core/maker/randoms/limits.hpp>
+#include <vector>
 
 namespace testcaser {
 namespace maker {
@@ -30,10 +38,27 @@ namespace maker {
  */
 namespace types {
 
+/**
+ * @brief Returns the engine to share, or a new engine seeded from
+ * std::random_device when engine is empty. Random types given the same engine
+ * draw from a single stream, so one seed drives all of them.
+ *
+ * @tparam Generator the random number generator
+ * @param engine the engine to share, may be empty
+ * @return std::shared_ptr<Generator> the engine to use
+ */
+template <class Generator>
+std::shared_ptr<Generator> share_or_create(std::shared_ptr<Generator> engine) {
+  if (engine) return engine;
+  return std::make_shared<Generator>(std::random_device()());
+}
+
 /**
  * @brief RandomType The core random type that holds the random generation logic
  * inside of itself. Do not instantiate this object it is for internal purpose
- * only.
+ * only. Drawing advances the engine even though get() is const, so an object
+ * must not be used by two threads at once unless its engine is a
+ * threads::LocalEngine, which draws from the engine of the calling thread.
  *
  * @tparam RNG the Random Number Generator
  * @tparam DistributionType The distribution type to use for this generator
@@ -42,27 +67,45 @@ namespace types {
 template <class RNG, class DistributionType>
 
 class RandomType {
-  RNG& engine;
+  // the engine drawn from. It is owned, shared with other random types or,
+  // when built from a reference, not owned at all.
+  std::shared_ptr<RNG> engine;
+
+  template <class Dist>
+  auto fill(Dist& dist, typename Dist::result_type* out, std::size_t count,
+            int) const -> decltype(dist.fill(*engine, out, count), void()) {
+    dist.fill(*engine, out, count);
+  }
+  template <class Dist>
+  void fill(Dist& dist, typename Dist::result_type* out, std::size_t count,
+            long) const {
+    for (std::size_t t = 0; t < count; t++) out[t] = dist(*engine);
+  }
+
+ public:
   /**
    * @brief Seeds the value to the Random number engine
    *
    * @param seed the value to seed
    */
-  void seed_value(typename RNG::result_type seed) { engine.seed(seed); }
-
-  // ? std::random_device is very sucepticle to copy and move construction. How
-  // ? about we pass its value directly after seeding.
-
- public:
+  void seed_value(typename RNG::result_type seed) { engine->seed(seed); }
   /**
    * @brief Construct a new Random Type object
    *
-   * @param gen the generator object.
+   * @param gen the generator object. It must outlive this object.
    * @param seed the value to seed
    */
-  RandomType(RNG& gen, typename RNG::result_type seed) : engine(gen) {
+  RandomType(RNG& gen, typename RNG::result_type seed)
+      : engine(std::shared_ptr<RNG>(), &gen) {
     seed_value(seed);
   }
+  /**
+   * @brief Construct a new Random Type object drawing from a shared engine.
+   * The engine is used as it is, without seeding.
+   *
+   * @param gen the engine to share
+   */
+  explicit RandomType(std::shared_ptr<RNG> gen) : engine(std::move(gen)) {}
   /**
    * @brief returns the value from the generator over the distribution
    *
@@ -71,8 +114,34 @@ class RandomType {
    * distribution
    */
   typename DistributionType::result_type get(DistributionType& dist) const {
-    return dist(engine);
+    return dist(*engine);
   }
+  /**
+   * @brief Fills the range with count values of the distribution. The
+   * distributions having a bulk fill(..), like distributions::BoundedInteger,
+   * generate them at once.
+   *
+   * @param dist the distribution object
+   * @param out the pointer to the first value to fill
+   * @param count the number of values
+   */
+  void fill(DistributionType& dist,
+            typename DistributionType::result_type* out,
+            std::size_t count) const {
+    this->fill(dist, out, count, 0);
+  }
+  /**
+   * @brief Get the engine drawn from.
+   *
+   * @return RNG& the engine
+   */
+  RNG& get_engine() const { return *engine; }
+  /**
+   * @brief Get the engine drawn from, to share it with other random types.
+   *
+   * @return std::shared_ptr<RNG> the engine
+   */
+  std::shared_ptr<RNG> share_engine() const { return engine; }
 };
 
 /**
@@ -80,16 +149,25 @@ class RandomType {
  * called it follows the generator and the distribution type that you provide.
  *
  * @tparam std::mt19937 The default Random Number generator to use
- * @tparam std::uniform_int_distribution<long long> The default distribution to
+ * @tparam distributions::BoundedInteger<long long> The default distribution to
  * use
  */
 
 template <class Generator = std::mt19937,
-          class Distribution = std::uniform_int_distribution<long long>>
+          class Distribution = distributions::BoundedInteger<long long>>
 class RandomInteger {
   testcaser::maker::RandomIntegerLimit const limit;
+  // the allowed values of the limit. Values are drawn by their number in
+  // ranges, offset by the lower limit, so that a draw is never rejected.
+  testcaser::maker::limits::AllowedRanges<long long> const ranges;
+  // the distribution over the numbers, built once with its thresholds
+  mutable Distribution dist;
   RandomType<Generator, Distribution> rt;
-  Generator gen;
+
+  long long value_of(long long drawn) const {
+    return ranges.at(static_cast<unsigned long long>(drawn) -
+                     static_cast<unsigned long long>(limit.LowerLimit));
+  }
 
  public:
   /**
@@ -97,46 +175,64 @@ class RandomInteger {
    * of Long Long of C++.
    *
    */
-  RandomInteger()
+  RandomInteger() : RandomInteger(std::shared_ptr<Generator>()) {}
+  /**
+   * @brief Construct a new Random Integer object over the range of Long Long
+   * drawing from a shared engine.
+   *
+   * @param engine the engine to draw from, a new one is created when empty
+   */
+  explicit RandomInteger(std::shared_ptr<Generator> engine)
       : limit({__LONG_LONG_MAX__, -__LONG_LONG_MAX__}),
-        gen(std::random_device()()),
-        rt(RandomType<Generator, Distribution>{gen, std::random_device()()}) {}
+        ranges(limit.allowed_ranges()),
+        dist(limit.LowerLimit,
+             limits::advance(limit.LowerLimit, ranges.size() - 1)),
+        rt(share_or_create(engine)) {}
   /**
    * @brief Construct a new Random Integer object
    *
    * @param lmt the limit to set on the range of random number generated
+   * @param engine the engine to draw from, a new one is created when empty
    */
   // cppcheck-suppress noExplicitConstructor
-  RandomInteger(testcaser::maker::RandomIntegerLimit lmt)
+  RandomInteger(testcaser::maker::RandomIntegerLimit lmt,
+                 std::shared_ptr<Generator> engine = nullptr)
       : limit(lmt),
-        gen(std::random_device()()),
-        rt(RandomType<Generator, Distribution>{gen, std::random_device()()}) {}
+        ranges(limit.allowed_ranges()),
+        dist(limit.LowerLimit,
+             limits::advance(limit.LowerLimit, ranges.size() - 1)),
+        rt(share_or_create(engine)) {}
   /**
    * @brief Construct a new Random Integer object
    *
    * @param lst the range as a initializer list
+   * @param engine the engine to draw from, a new one is created when empty
    */
   // cppcheck-suppress noExplicitConstructor
-  RandomInteger(std::initializer_list<long long> lst)
+  RandomInteger(std::initializer_list<long long> lst,
+                 std::shared_ptr<Generator> engine = nullptr)
       : limit(testcaser::maker::RandomIntegerLimit{lst}),
-        gen(std::random_device()()),
-        rt(RandomType<Generator, Distribution>{gen, std::random_device()()}) {}
+        ranges(limit.allowed_ranges()),
+        dist(limit.LowerLimit,
+             limits::advance(limit.LowerLimit, ranges.size() - 1)),
+        rt(share_or_create(engine)) {}
   /**
    * @brief returns the random number from this class
    *
    * @return long long the value of the random number
    */
-  long long get() const {
-    /**
-     * @todo Make get() startegy even better.
-     * @body The sampling of the distribution can be inefficent when too many
-     * except_intervals are specified. Improve this startegy
-     *
-     */
-    Distribution dis{limit.LowerLimit, limit.UpperLimit - 1};
-    long long out = rt.get(dis);
-    while (!limit.valid_output(out)) out = rt.get(dis);
-    return out;
+  long long get() const { return this->value_of(rt.get(dist)); }
+  /**
+   * @brief Fills the range with count random numbers. It saves the call
+   * overhead of calling get() count times, the numbers are drawn in batches
+   * by the distribution.
+   *
+   * @param out the pointer to the first value to fill
+   * @param count the number of values to generate
+   */
+  void fill(long long* out, std::size_t count) const {
+    rt.fill(dist, out, count);
+    for (std::size_t t = 0; t < count; t++) out[t] = this->value_of(out[t]);
   }
 
   /**
@@ -154,10 +250,15 @@ class RandomInteger {
           " while Upper Limit on this random number was set to " +
           std::to_string(limit.UpperLimit));
     } else {
-      Distribution dis{val, limit.UpperLimit - 1};
-      long long out = rt.get(dis);
-      while (!limit.valid_output(out)) out = rt.get(dis);
-      return out;
+      unsigned long long const skipped = ranges.rank(val);
+      if (skipped == ranges.size()) {
+        throw testcaser::exceptions::maker::LimitExhaustedError(
+            "No value more than " + std::to_string(val) +
+            " is allowed by the interval exceptions of this random number");
+      }
+      Distribution dis{limits::advance(limit.LowerLimit, skipped),
+                       limits::advance(limit.LowerLimit, ranges.size() - 1)};
+      return this->value_of(rt.get(dis));
     }
   }
   /**
@@ -175,10 +276,16 @@ class RandomInteger {
           " while Lower Limit on this random number was set to " +
           std::to_string(limit.LowerLimit));
     } else {
-      Distribution dis{limit.LowerLimit, val};
-      long long out = rt.get(dis);
-      while (!limit.valid_output(out)) out = rt.get(dis);
-      return out;
+      unsigned long long const allowed =
+          ranges.rank(val) + (limit.valid_output(val) ? 1 : 0);
+      if (allowed == 0) {
+        throw testcaser::exceptions::maker::LimitExhaustedError(
+            "No value less than " + std::to_string(val) +
+            " is allowed by the interval exceptions of this random number");
+      }
+      Distribution dis{limit.LowerLimit,
+                       limits::advance(limit.LowerLimit, allowed - 1)};
+      return this->value_of(rt.get(dis));
     }
   }
 
@@ -198,6 +305,19 @@ class RandomInteger {
   void reseed_engine_with_random_device() {
     rt.seed_value(std::random_device()());
   }
+  /**
+   * @brief Get the engine of this object. Engines like engines::Philox4x32
+   * can be moved to any position through it.
+   *
+   * @return Generator& the engine
+   */
+  Generator& get_engine() { return rt.get_engine(); }
+  /**
+   * @brief Get the engine of this object to share it with other random types.
+   *
+   * @return std::shared_ptr<Generator> the engine
+   */
+  std::shared_ptr<Generator> share_engine() const { return rt.share_engine(); }
 };
 
 /**
@@ -206,60 +326,94 @@ class RandomInteger {
  * provide.
  *
  * @tparam std::mt19937 the default generator to use
- * @tparam std::uniform_int_distribution<unsigned long long> the default
+ * @tparam distributions::BoundedInteger<unsigned long long> the default
  * distribution to use
  */
 
 template <class Generator = std::mt19937,
           class Distribution =
-              std::uniform_int_distribution<unsigned long long>>
+              distributions::BoundedInteger<unsigned long long>>
 class RandomUnsignedInteger {
   testcaser::maker::RandomUnsignedIntegerLimit const limit;
-  Generator gen;
+  // the allowed values of the limit. Values are drawn by their number in
+  // ranges, offset by the lower limit, so that a draw is never rejected.
+  testcaser::maker::limits::AllowedRanges<unsigned long long> const ranges;
+  // the distribution over the numbers, built once with its thresholds
+  mutable Distribution dist;
   RandomType<Generator, Distribution> rt;
 
+  unsigned long long value_of(unsigned long long drawn) const {
+    return ranges.at(static_cast<unsigned long long>(drawn) -
+                     static_cast<unsigned long long>(limit.LowerLimit));
+  }
+
  public:
   /**
    * @brief Construct a new Random Unsigned Integer object
    *
    */
   RandomUnsignedInteger()
+      : RandomUnsignedInteger(std::shared_ptr<Generator>()) {}
+  /**
+   * @brief Construct a new Random Unsigned Integer object drawing from a
+   * shared engine.
+   *
+   * @param engine the engine to draw from, a new one is created when empty
+   */
+  explicit RandomUnsignedInteger(std::shared_ptr<Generator> engine)
       : limit({static_cast<unsigned long long>(__LONG_LONG_MAX__) * 2, 0}),
-        gen(std::random_device()()),
-        rt(RandomType<Generator, Distribution>{gen, std::random_device()()}) {}
+        ranges(limit.allowed_ranges()),
+        dist(limit.LowerLimit,
+             limits::advance(limit.LowerLimit, ranges.size() - 1)),
+        rt(share_or_create(engine)) {}
 
   /**
    * @brief Construct a new Random Unsigned Integer object
    *
    * @param lmt the random number limit to put on the generator
+   * @param engine the engine to draw from, a new one is created when empty
    */
   // cppcheck-suppress noExplicitConstructor
-  RandomUnsignedInteger(testcaser::maker::RandomUnsignedIntegerLimit lmt)
+  RandomUnsignedInteger(testcaser::maker::RandomUnsignedIntegerLimit lmt,
+                         std::shared_ptr<Generator> engine = nullptr)
       : limit(lmt),
-        gen(std::random_device()()),
-        rt(RandomType<Generator, Distribution>{gen, std::random_device()()}) {}
+        ranges(limit.allowed_ranges()),
+        dist(limit.LowerLimit,
+             limits::advance(limit.LowerLimit, ranges.size() - 1)),
+        rt(share_or_create(engine)) {}
 
   /**
    * @brief Construct a new Random Unsigned Integer object
    *
    * @param lst the limit in the form of initializer list
+   * @param engine the engine to draw from, a new one is created when empty
    */
   // cppcheck-suppress noExplicitConstructor
-  RandomUnsignedInteger(std::initializer_list<unsigned long long> lst)
+  RandomUnsignedInteger(std::initializer_list<unsigned long long> lst,
+                         std::shared_ptr<Generator> engine = nullptr)
       : limit(testcaser::maker::RandomUnsignedIntegerLimit{lst}),
-        gen(std::random_device()()),
-        rt(RandomType<Generator, Distribution>{gen, std::random_device()()}) {}
+        ranges(limit.allowed_ranges()),
+        dist(limit.LowerLimit,
+             limits::advance(limit.LowerLimit, ranges.size() - 1)),
+        rt(share_or_create(engine)) {}
 
   /**
    * @brief returns the random number generated
    *
    * @return unsigned long long the value returned
    */
-  unsigned long long get() const {
-    Distribution dis{limit.LowerLimit, limit.UpperLimit - 1};
-    unsigned long long out = rt.get(dis);
-    while (!limit.valid_output(out)) out = rt.get(dis);
-    return out;
+  unsigned long long get() const { return this->value_of(rt.get(dist)); }
+  /**
+   * @brief Fills the range with count random numbers. It saves the call
+   * overhead of calling get() count times, the numbers are drawn in batches
+   * by the distribution.
+   *
+   * @param out the pointer to the first value to fill
+   * @param count the number of values to generate
+   */
+  void fill(unsigned long long* out, std::size_t count) const {
+    rt.fill(dist, out, count);
+    for (std::size_t t = 0; t < count; t++) out[t] = this->value_of(out[t]);
   }
   /**
    * @brief Get the random Integer non-strictly more than the value specified.
@@ -276,10 +430,15 @@ class RandomUnsignedInteger {
           " while Upper Limit on this random number was set to " +
           std::to_string(limit.UpperLimit));
     } else {
-      Distribution dis{val, limit.UpperLimit - 1};
-      unsigned long long out = rt.get(dis);
-      while (!limit.valid_output(out)) out = rt.get(dis);
-      return out;
+      unsigned long long const skipped = ranges.rank(val);
+      if (skipped == ranges.size()) {
+        throw testcaser::exceptions::maker::LimitExhaustedError(
+            "No value more than " + std::to_string(val) +
+            " is allowed by the interval exceptions of this random number");
+      }
+      Distribution dis{limits::advance(limit.LowerLimit, skipped),
+                       limits::advance(limit.LowerLimit, ranges.size() - 1)};
+      return this->value_of(rt.get(dis));
     }
   }
   /**
@@ -298,10 +457,16 @@ class RandomUnsignedInteger {
           " while Lower Limit on this random number was set to " +
           std::to_string(limit.LowerLimit));
     } else {
-      Distribution dis{limit.LowerLimit, val};
-      unsigned long long out = rt.get(dis);
-      while (!limit.valid_output(out)) out = rt.get(dis);
-      return out;
+      unsigned long long const allowed =
+          ranges.rank(val) + (limit.valid_output(val) ? 1 : 0);
+      if (allowed == 0) {
+        throw testcaser::exceptions::maker::LimitExhaustedError(
+            "No value less than " + std::to_string(val) +
+            " is allowed by the interval exceptions of this random number");
+      }
+      Distribution dis{limit.LowerLimit,
+                       limits::advance(limit.LowerLimit, allowed - 1)};
+      return this->value_of(rt.get(dis));
     }
   }
   /**
@@ -320,6 +485,407 @@ class RandomUnsignedInteger {
   void reseed_engine_with_random_device() {
     rt.seed_value(std::random_device()());
   }
+  /**
+   * @brief Get the engine of this object. Engines like engines::Philox4x32
+   * can be moved to any position through it.
+   *
+   * @return Generator& the engine
+   */
+  Generator& get_engine() { return rt.get_engine(); }
+  /**
+   * @brief Get the engine of this object to share it with other random types.
+   *
+   * @return std::shared_ptr<Generator> the engine
+   */
+  std::shared_ptr<Generator> share_engine() const { return rt.share_engine(); }
+};
+
+/**
+ * @brief ShapedRandom The core of the random integers following a distribution
+ * other than the uniform one, such as RandomNormal. The values of the
+ * distribution are rounded to the nearest integer and clamped to the nearest
+ * value allowed by the limit. Do not instantiate this object it is for
+ * internal purpose only.
+ *
+ * @tparam Generator the random number generator to use
+ * @tparam Distribution the distribution of the values
+ */
+template <class Generator, class Distribution>
+class ShapedRandom {
+  testcaser::maker::RandomIntegerLimit const limit;
+  mutable Distribution dist;
+  RandomType<Generator, Distribution> rt;
+
+  static long long nearest(long long value) { return value; }
+  static long long nearest(double value) {
+    if (value >= 9.2233720368547758e18) return __LONG_LONG_MAX__;
+    if (value <= -9.2233720368547758e18) return -__LONG_LONG_MAX__ - 1;
+    return std::llround(value);
+  }
+
+ protected:
+  /**
+   * @brief Construct a new Shaped Random object
+   *
+   * @param distribution the distribution of the values
+   * @param lmt the limit the values are clamped to
+   * @param engine the engine to draw from, a new one is created when empty
+   */
+  ShapedRandom(Distribution distribution,
+               testcaser::maker::RandomIntegerLimit lmt,
+               std::shared_ptr<Generator> engine)
+      : limit(lmt), dist(distribution), rt(share_or_create(engine)) {}
+  /**
+   * @brief The limit of the whole range of Long Long, the default limit.
+   *
+   */
+  static testcaser::maker::RandomIntegerLimit whole_range() {
+    return testcaser::maker::RandomIntegerLimit(__LONG_LONG_MAX__,
+                                                -__LONG_LONG_MAX__);
+  }
+
+ public:
+  /**
+   * @brief returns the random number from this class
+   *
+   * @return long long the value of the random number
+   */
+  long long get() const { return limit.clamp(nearest(rt.get(dist))); }
+  /**
+   * @brief Fills the range with count random numbers, the same numbers as
+   * count calls of get().
+   *
+   * @param out the pointer to the first value to fill
+   * @param count the number of values to generate
+   */
+  void fill(long long* out, std::size_t count) const {
+    typename Distribution::result_type raw[64];
+    while (count > 0) {
+      std::size_t const batch = count < 64 ? count : 64;
+      rt.fill(dist, raw, batch);
+      for (std::size_t t = 0; t < batch; t++)
+        out[t] = limit.clamp(nearest(raw[t]));
+      out += batch;
+      count -= batch;
+    }
+  }
+  /**
+   * @brief The distribution of the values, before rounding and clamping.
+   *
+   * @return Distribution const& the distribution
+   */
+  Distribution const& distribution() const { return dist; }
+  /**
+   * @brief reseeds the generator with a new seed value
+   *
+   * @param seed the value to seed the generator
+   */
+  void reseed_engine(typename Generator::result_type seed) {
+    rt.seed_value(seed);
+  }
+  /**
+   * @brief reseed the random number engine with the random value. It uses
+   * std::random_device()() for this task.
+   *
+   */
+  void reseed_engine_with_random_device() {
+    rt.seed_value(std::random_device()());
+  }
+  /**
+   * @brief Get the engine of this object.
+   *
+   * @return Generator& the engine
+   */
+  Generator& get_engine() { return rt.get_engine(); }
+  /**
+   * @brief Get the engine of this object to share it with other random types.
+   *
+   * @return std::shared_ptr<Generator> the engine
+   */
+  std::shared_ptr<Generator> share_engine() const { return rt.share_engine(); }
+};
+
+/**
+ * @brief RandomNormal object generates normally distributed random integers,
+ * the values of the normal distribution rounded to the nearest integer.
+ *
+ * @tparam std::mt19937 The default Random Number generator to use
+ * @tparam distributions::Normal The default distribution to use
+ */
+template <class Generator = std::mt19937,
+          class Distribution = distributions::Normal>
+class RandomNormal : public ShapedRandom<Generator, Distribution> {
+ public:
+  /**
+   * @brief Construct a new Random Normal object
+   *
+   * @param mean the mean of the values
+   * @param stddev the standard deviation of the values
+   * @param lmt the limit the values are clamped to, the whole range of Long
+   * Long by default
+   * @param engine the engine to draw from, a new one is created when empty
+   */
+  RandomNormal(double mean, double stddev,
+               testcaser::maker::RandomIntegerLimit lmt =
+                   ShapedRandom<Generator, Distribution>::whole_range(),
+               std::shared_ptr<Generator> engine = nullptr)
+      : ShapedRandom<Generator, Distribution>(Distribution(mean, stddev), lmt,
+                                              engine) {}
+};
+
+/**
+ * @brief RandomExponential object generates exponentially distributed random
+ * integers, the values of the exponential distribution rounded to the nearest
+ * integer.
+ *
+ * @tparam std::mt19937 The default Random Number generator to use
+ * @tparam distributions::Exponential The default distribution to use
+ */
+template <class Generator = std::mt19937,
+          class Distribution = distributions::Exponential>
+class RandomExponential : public ShapedRandom<Generator, Distribution> {
+ public:
+  /**
+   * @brief Construct a new Random Exponential object
+   *
+   * @param rate the rate of the values, their mean is 1 / rate
+   * @param lmt the limit the values are clamped to, the whole range of Long
+   * Long by default
+   * @param engine the engine to draw from, a new one is created when empty
+   */
+  explicit RandomExponential(
+      double rate,
+      testcaser::maker::RandomIntegerLimit lmt =
+          ShapedRandom<Generator, Distribution>::whole_range(),
+      std::shared_ptr<Generator> engine = nullptr)
+      : ShapedRandom<Generator, Distribution>(Distribution(rate), lmt,
+                                              engine) {}
+};
+
+/**
+ * @brief RandomGeometric object generates the number of failures before the
+ * first success of trials succeeding with a probability.
+ *
+ * @tparam std::mt19937 The default Random Number generator to use
+ * @tparam distributions::Geometric The default distribution to use
+ */
+template <class Generator = std::mt19937,
+          class Distribution = distributions::Geometric>
+class RandomGeometric : public ShapedRandom<Generator, Distribution> {
+ public:
+  /**
+   * @brief Construct a new Random Geometric object
+   *
+   * @param p the probability of a success, in (0, 1]
+   * @param lmt the limit the values are clamped to, the whole range of Long
+   * Long by default
+   * @param engine the engine to draw from, a new one is created when empty
+   */
+  explicit RandomGeometric(
+      double p,
+      testcaser::maker::RandomIntegerLimit lmt =
+          ShapedRandom<Generator, Distribution>::whole_range(),
+      std::shared_ptr<Generator> engine = nullptr)
+      : ShapedRandom<Generator, Distribution>(Distribution(p), lmt, engine) {}
+};
+
+/**
+ * @brief RandomPoisson object generates Poisson distributed random integers,
+ * like the number of events of a given rate in a unit of time.
+ *
+ * @tparam std::mt19937 The default Random Number generator to use
+ * @tparam distributions::Poisson The default distribution to use
+ */
+template <class Generator = std::mt19937,
+          class Distribution = distributions::Poisson>
+class RandomPoisson : public ShapedRandom<Generator, Distribution> {
+ public:
+  /**
+   * @brief Construct a new Random Poisson object
+   *
+   * @param mean the mean of the values
+   * @param lmt the limit the values are clamped to, the whole range of Long
+   * Long by default
+   * @param engine the engine to draw from, a new one is created when empty
+   */
+  explicit RandomPoisson(
+      double mean,
+      testcaser::maker::RandomIntegerLimit lmt =
+          ShapedRandom<Generator, Distribution>::whole_range(),
+      std::shared_ptr<Generator> engine = nullptr)
+      : ShapedRandom<Generator, Distribution>(Distribution(mean), lmt,
+                                              engine) {}
+};
+
+/**
+ * @brief RandomZipf object generates Zipf distributed ranks of 1 ... n, rank k
+ * being drawn with a probability proportional to 1 / k^exponent. Use it for
+ * skewed keys where a few hot keys take most of the load, rank 1 being the
+ * hottest.
+ *
+ * @tparam std::mt19937 The default Random Number generator to use
+ * @tparam distributions::Zipf The default distribution to use
+ */
+template <class Generator = std::mt19937,
+          class Distribution = distributions::Zipf>
+class RandomZipf : public ShapedRandom<Generator, Distribution> {
+ public:
+  /**
+   * @brief Construct a new Random Zipf object
+   *
+   * @param n the number of ranks
+   * @param exponent the exponent of the ranks, positive
+   * @param lmt the limit the values are clamped to, the whole range of Long
+   * Long by default
+   * @param engine the engine to draw from, a new one is created when empty
+   */
+  RandomZipf(long long n, double exponent,
+             testcaser::maker::RandomIntegerLimit lmt =
+                 ShapedRandom<Generator, Distribution>::whole_range(),
+             std::shared_ptr<Generator> engine = nullptr)
+      : ShapedRandom<Generator, Distribution>(Distribution(n, exponent), lmt,
+                                              engine) {}
+};
+
+/**
+ * @brief StaticRandom generates the values of a StaticLimit. The limit is known
+ * at compile time, so the object holds nothing but its engine: the rejection
+ * threshold is a constant, which is 0 and removes the rejection entirely when
+ * the number of allowed values is a power of two, and excluded values are
+ * skipped without any runtime limit.
+ *
+ * @tparam Limit the StaticLimit to generate values of
+ * @tparam Generator the random number generator to use
+ */
+template <class Limit, class Generator = std::mt19937>
+class StaticRandom {
+  static_assert(Limit::size() <= 0xFFFFFFFFull,
+                "StaticRandom supports limits of atmost 2^32 values");
+  std::shared_ptr<Generator> engine;
+
+  static constexpr std::uint64_t span() { return Limit::size(); }
+  static constexpr std::uint32_t threshold() {
+    return static_cast<std::uint32_t>((0x100000000ull - span()) % span());
+  }
+  static constexpr bool is_power_of_two() {
+    return (span() & (span() - 1)) == 0;
+  }
+  static constexpr int log2(std::uint64_t value) {
+    return value <= 1 ? 0 : 1 + log2(value >> 1);
+  }
+  // the largest count for which span()^count fits in 64 bits
+  static constexpr int packed(std::uint64_t power = 1, int count = 0) {
+    return span() > 1 && power <= ~0ull / span()
+               ? packed(power * span(), count + 1)
+               : count;
+  }
+  static constexpr std::uint64_t power(int count) {
+    return count == 0 ? 1 : span() * power(count - 1);
+  }
+  // the number of values fill(..) extracts from a single 64 bit draw
+  static constexpr int per_draw() {
+    return span() < 2 ? 0
+                      : is_power_of_two() ? 64 / log2(span()) : packed();
+  }
+  static constexpr std::uint64_t packed_threshold() {
+    return (0 - power(packed())) % power(packed());
+  }
+
+  // draws a value of [0, span()^per_draw()), its digits in radix span() are
+  // per_draw() independent uniform values
+  static std::uint64_t draw_packed(Generator& gen) {
+    if (is_power_of_two()) return distributions::Bits::draw64(gen);
+    engines::wide::uint128 product = engines::wide::multiply(
+        distributions::Bits::draw64(gen), power(packed()));
+    while (engines::wide::low(product) < packed_threshold())
+      product = engines::wide::multiply(distributions::Bits::draw64(gen),
+                                        power(packed()));
+    return engines::wide::high(product);
+  }
+
+ public:
+  /**
+   * @brief The type of the values generated.
+   *
+   */
+  typedef typename Limit::value_type value_type;
+  /**
+   * @brief Construct a new Static Random object
+   *
+   */
+  StaticRandom() : StaticRandom(std::shared_ptr<Generator>()) {}
+  /**
+   * @brief Construct a new Static Random object drawing from a shared engine.
+   *
+   * @param engine the engine to draw from, a new one is created when empty
+   */
+  explicit StaticRandom(std::shared_ptr<Generator> engine)
+      : engine(share_or_create(engine)) {}
+  /**
+   * @brief returns a random value of the limit
+   *
+   * @return value_type the value
+   */
+  value_type get() const {
+    Generator& gen = *engine;
+    std::uint64_t product =
+        static_cast<std::uint64_t>(distributions::Bits::draw32(gen)) * span();
+    while (static_cast<std::uint32_t>(product) < threshold())
+      product =
+          static_cast<std::uint64_t>(distributions::Bits::draw32(gen)) * span();
+    return Limit::at(product >> 32);
+  }
+  /**
+   * @brief Fills the range with count random values, each shifted by offset.
+   * Small limits are packed: a single 64 bit draw gives 64 binary digits, 40
+   * ternary digits, 32 quaternary digits and so on.
+   *
+   * @param out the pointer to the first value to fill
+   * @param count the number of values to generate
+   * @param offset the value added to every value, '0' turns digits to ASCII
+   */
+  template <class T>
+  void fill(T* out, std::size_t count, T offset = T()) const {
+    if (per_draw() < 2) {
+      for (std::size_t t = 0; t < count; t++)
+        out[t] = static_cast<T>(this->get() + offset);
+      return;
+    }
+    Generator& gen = *engine;
+    while (count > 0) {
+      std::uint64_t packed_values = draw_packed(gen);
+      std::size_t const batch =
+          count < static_cast<std::size_t>(per_draw())
+              ? count
+              : static_cast<std::size_t>(per_draw());
+      for (std::size_t t = 0; t < batch; t++) {
+        out[t] = static_cast<T>(Limit::at(packed_values % span()) + offset);
+        packed_values /= span();
+      }
+      out += batch;
+      count -= batch;
+    }
+  }
+  /**
+   * @brief reseeds the generator with a new seed value
+   *
+   * @param seed the value to seed the generator
+   */
+  void reseed_engine(typename Generator::result_type seed) {
+    engine->seed(seed);
+  }
+  /**
+   * @brief Get the engine of this object.
+   *
+   * @return Generator& the engine
+   */
+  Generator& get_engine() { return *engine; }
+  /**
+   * @brief Get the engine of this object to share it with other random types.
+   *
+   * @return std::shared_ptr<Generator> the engine
+   */
+  std::shared_ptr<Generator> share_engine() const { return engine; }
 };
 
 /**
@@ -327,39 +893,72 @@ class RandomUnsignedInteger {
  * called it follows the generator and the distribution type that you provide.
  *
  * @tparam std::mt19937 the random number generator to use
- * @tparam std::uniform_int_distribution<unsigned long long> the distribution to
- * use to sample the random number
+ * @tparam distributions::BoundedInteger<unsigned long long> unused, the values
+ * are sampled by StaticRandom from a limit known at compile time
  */
 template <class Generator = std::mt19937,
           class Distribution =
-              std::uniform_int_distribution<unsigned long long>>
+              distributions::BoundedInteger<unsigned long long>>
 struct RandomBinary {
   /**
-   * @brief rui the RandomUnsignedInteger object to generate binary numbers with
-   * binary limit
+   * @brief rui the generator of the digits, its limit is known at compile
+   * time
    *
    */
-  RandomUnsignedInteger<Generator, Distribution> rui;
+  StaticRandom<limits::StaticDigits<2>::type, Generator> rui;
 
   /**
    * @brief Construct a new Random Binary object
    *
    */
-  RandomBinary()
-      : rui(RandomUnsignedInteger<Generator, Distribution>{{2, 0}}) {}
+  RandomBinary() {}
+  /**
+   * @brief Construct a new Random Binary object drawing from a shared engine
+   *
+   * @param engine the engine to draw from, a new one is created when empty
+   */
+  explicit RandomBinary(std::shared_ptr<Generator> engine) : rui(engine) {}
   /**
    * @brief Get the random value as boolean object
    *
    * @return true
    * @return false
    */
-  bool get_as_boolean() { return rui.get() == 1 ? true : false; }
+  bool get_as_boolean() { return rui.get() == 1; }
   /**
    * @brief Get the random value as int object
    *
    * @return unsigned long long
    */
   unsigned long long get_as_int() const { return rui.get(); }
+  /**
+   * @brief Fills the range with count binary digits, 64 of them are taken
+   * from a single draw of the engine.
+   *
+   * @param out the pointer to the first value to fill
+   * @param count the number of digits to generate
+   */
+  void fill(unsigned long long* out, std::size_t count) const {
+    rui.fill(out, count);
+  }
+  /**
+   * @brief Fills the range with count binary digits as the characters '0'
+   * and '1'.
+   *
+   * @param out the pointer to the first character to fill
+   * @param count the number of digits to generate
+   */
+  void fill_digits(char* out, std::size_t count) const {
+    rui.fill(out, count, '0');
+  }
+  /**
+   * @brief reseeds the generator with a new seed value
+   *
+   * @param seed the value to seed the generator
+   */
+  void reseed_engine(typename Generator::result_type seed) {
+    rui.reseed_engine(seed);
+  }
 };
 
 /**
@@ -367,34 +966,67 @@ struct RandomBinary {
  * called it follows the generator and the distribution type that you provide.
  *
  * @tparam std::mt19937 the random number generator to use
- * @tparam std::uniform_int_distribution<unsigned long long> the distribution to
- * use to sample the random number
+ * @tparam distributions::BoundedInteger<unsigned long long> unused, the values
+ * are sampled by StaticRandom from a limit known at compile time
  */
 template <class Generator = std::mt19937,
           class Distribution =
-              std::uniform_int_distribution<unsigned long long>>
+              distributions::BoundedInteger<unsigned long long>>
 struct RandomTernary {
   /**
-   * @brief rui the RandomUnsignedInteger object to ternary numbers with ternary
-   * limit
+   * @brief rui the generator of the digits, its limit is known at compile
+   * time
+   *
+   */
+  StaticRandom<limits::StaticDigits<3>::type, Generator> rui;
+  /**
+   * @brief first the smallest digit, 0 or 1
    *
    */
-  RandomUnsignedInteger<Generator, Distribution> rui;
+  unsigned long long first;
   /**
    * @brief Construct a new Random Ternary object
    *
    * @param one_based should the ternary start with 1 index or 0 index
+   * @param engine the engine to draw from, a new one is created when empty
    */
   // cppcheck-suppress noExplicitConstructor
-  RandomTernary(bool one_based = false)
-      : rui(RandomUnsignedInteger<Generator, Distribution>(
-            {one_based ? 4ull : 3ull, one_based ? 1ull : 0ull})) {}
+  RandomTernary(bool one_based = false,
+                std::shared_ptr<Generator> engine = nullptr)
+      : rui(engine), first(one_based ? 1 : 0) {}
   /**
    * @brief Get the value as int object
    *
    * @return unsigned long long
    */
-  unsigned long long get_as_int() const { return rui.get(); }
+  unsigned long long get_as_int() const { return rui.get() + first; }
+  /**
+   * @brief Fills the range with count ternary digits, many of them are taken
+   * from a single draw of the engine.
+   *
+   * @param out the pointer to the first value to fill
+   * @param count the number of digits to generate
+   */
+  void fill(unsigned long long* out, std::size_t count) const {
+    rui.fill(out, count, first);
+  }
+  /**
+   * @brief Fills the range with count ternary digits as characters.
+   *
+   * @param out the pointer to the first character to fill
+   * @param count the number of digits to generate
+   */
+  void fill_digits(char* out, std::size_t count) const {
+    rui.fill(out, count, static_cast<char>('0' + first));
+  }
+  /**
+   * @brief reseeds the generator with a new seed value
+   *
+   * @param seed the value to seed the generator
+   */
+  void reseed_engine(typename Generator::result_type seed) {
+    rui.reseed_engine(seed);
+  }
 };
 
 /**
@@ -403,35 +1035,68 @@ struct RandomTernary {
  * provide.
  *
  * @tparam std::mt19937 the random number generator to use
- * @tparam std::uniform_int_distribution<unsigned long long> the distribution to
- * use to sample the random number
+ * @tparam distributions::BoundedInteger<unsigned long long> unused, the values
+ * are sampled by StaticRandom from a limit known at compile time
  */
 
 template <class Generator = std::mt19937,
           class Distribution =
-              std::uniform_int_distribution<unsigned long long>>
+              distributions::BoundedInteger<unsigned long long>>
 struct RandomQuaternary {
   /**
-   * @brief rui the RandomUnsignedInteger object to quaternary numbers with
-   * quaternary limit
+   * @brief rui the generator of the digits, its limit is known at compile
+   * time
+   *
+   */
+  StaticRandom<limits::StaticDigits<4>::type, Generator> rui;
+  /**
+   * @brief first the smallest digit, 0 or 1
    *
    */
-  RandomUnsignedInteger<Generator, Distribution> rui;
+  unsigned long long first;
   /**
    * @brief Construct a new Random Quaternary object
    *
    * @param one_based should use start with 0 or 1
+   * @param engine the engine to draw from, a new one is created when empty
    */
   // cppcheck-suppress noExplicitConstructor
-  RandomQuaternary(bool one_based = false)
-      : rui(RandomUnsignedInteger<Generator, Distribution>(
-            {one_based ? 5ull : 4ull, one_based ? 1ull : 0ull})) {}
+  RandomQuaternary(bool one_based = false,
+                   std::shared_ptr<Generator> engine = nullptr)
+      : rui(engine), first(one_based ? 1 : 0) {}
   /**
    * @brief Get the value as int object
    *
    * @return unsigned long long
    */
-  unsigned long long get_as_int() const { return rui.get(); }
+  unsigned long long get_as_int() const { return rui.get() + first; }
+  /**
+   * @brief Fills the range with count quaternary digits, many of them are taken
+   * from a single draw of the engine.
+   *
+   * @param out the pointer to the first value to fill
+   * @param count the number of digits to generate
+   */
+  void fill(unsigned long long* out, std::size_t count) const {
+    rui.fill(out, count, first);
+  }
+  /**
+   * @brief Fills the range with count quaternary digits as characters.
+   *
+   * @param out the pointer to the first character to fill
+   * @param count the number of digits to generate
+   */
+  void fill_digits(char* out, std::size_t count) const {
+    rui.fill(out, count, static_cast<char>('0' + first));
+  }
+  /**
+   * @brief reseeds the generator with a new seed value
+   *
+   * @param seed the value to seed the generator
+   */
+  void reseed_engine(typename Generator::result_type seed) {
+    rui.reseed_engine(seed);
+  }
 };
 
 /**
@@ -439,34 +1104,67 @@ struct RandomQuaternary {
  * called it follows the generator and the distribution type that you provide.
  *
  * @tparam std::mt19937 the random number generator to use
- * @tparam std::uniform_int_distribution<unsigned long long> the distribution to
- * use to sample the random number
+ * @tparam distributions::BoundedInteger<unsigned long long> unused, the values
+ * are sampled by StaticRandom from a limit known at compile time
  */
 template <class Generator = std::mt19937,
           class Distribution =
-              std::uniform_int_distribution<unsigned long long>>
+              distributions::BoundedInteger<unsigned long long>>
 struct RandomQuinary {
   /**
-   * @brief rui the RandomUnsignedInteger object to generate quinary numbers
-   * with quinary limit
+   * @brief rui the generator of the digits, its limit is known at compile
+   * time
    *
    */
-  RandomUnsignedInteger<Generator, Distribution> rui;
+  StaticRandom<limits::StaticDigits<5>::type, Generator> rui;
+  /**
+   * @brief first the smallest digit, 0 or 1
+   *
+   */
+  unsigned long long first;
   /**
    * @brief Construct a new Random Quinary object
    *
    * @param one_based use 0 or 1 as random number starting position
+   * @param engine the engine to draw from, a new one is created when empty
    */
   // cppcheck-suppress noExplicitConstructor
-  RandomQuinary(bool one_based = false)
-      : rui(RandomUnsignedInteger<Generator, Distribution>(
-            {one_based ? 6ull : 5ull, one_based ? 1ull : 0ull})) {}
+  RandomQuinary(bool one_based = false,
+                std::shared_ptr<Generator> engine = nullptr)
+      : rui(engine), first(one_based ? 1 : 0) {}
   /**
    * @brief Get the value as int object
    *
    * @return unsigned long long
    */
-  unsigned long long get_as_int() const { return rui.get(); }
+  unsigned long long get_as_int() const { return rui.get() + first; }
+  /**
+   * @brief Fills the range with count quinary digits, many of them are taken
+   * from a single draw of the engine.
+   *
+   * @param out the pointer to the first value to fill
+   * @param count the number of digits to generate
+   */
+  void fill(unsigned long long* out, std::size_t count) const {
+    rui.fill(out, count, first);
+  }
+  /**
+   * @brief Fills the range with count quinary digits as characters.
+   *
+   * @param out the pointer to the first character to fill
+   * @param count the number of digits to generate
+   */
+  void fill_digits(char* out, std::size_t count) const {
+    rui.fill(out, count, static_cast<char>('0' + first));
+  }
+  /**
+   * @brief reseeds the generator with a new seed value
+   *
+   * @param seed the value to seed the generator
+   */
+  void reseed_engine(typename Generator::result_type seed) {
+    rui.reseed_engine(seed);
+  }
 };
 
 /**
@@ -474,34 +1172,67 @@ struct RandomQuinary {
  * called it follows the generator and the distribution type that you provide.
  *
  * @tparam std::mt19937 the random number generator to use
- * @tparam std::uniform_int_distribution<unsigned long long> the distribution to
- * use to sample the random number
+ * @tparam distributions::BoundedInteger<unsigned long long> unused, the values
+ * are sampled by StaticRandom from a limit known at compile time
  */
 template <class Generator = std::mt19937,
           class Distribution =
-              std::uniform_int_distribution<unsigned long long>>
+              distributions::BoundedInteger<unsigned long long>>
 struct RandomSenary {
   /**
-   * @brief rui the RandomUnsignedInteger object to generate senary numbers with
-   * senary limit
+   * @brief rui the generator of the digits, its limit is known at compile
+   * time
+   *
+   */
+  StaticRandom<limits::StaticDigits<6>::type, Generator> rui;
+  /**
+   * @brief first the smallest digit, 0 or 1
    *
    */
-  RandomUnsignedInteger<Generator, Distribution> rui;
+  unsigned long long first;
   /**
    * @brief Construct a new Random Senary object
    *
    * @param one_based use the 0 or 1 as start of random number
+   * @param engine the engine to draw from, a new one is created when empty
    */
   // cppcheck-suppress noExplicitConstructor
-  RandomSenary(bool one_based = false)
-      : rui(RandomUnsignedInteger<Generator, Distribution>(
-            {one_based ? 7ull : 6ull, one_based ? 1ull : 0ull})) {}
+  RandomSenary(bool one_based = false,
+               std::shared_ptr<Generator> engine = nullptr)
+      : rui(engine), first(one_based ? 1 : 0) {}
   /**
    * @brief Get the value as int object
    *
    * @return unsigned long long
    */
-  unsigned long long get_as_int() const { return rui.get(); }
+  unsigned long long get_as_int() const { return rui.get() + first; }
+  /**
+   * @brief Fills the range with count senary digits, many of them are taken
+   * from a single draw of the engine.
+   *
+   * @param out the pointer to the first value to fill
+   * @param count the number of digits to generate
+   */
+  void fill(unsigned long long* out, std::size_t count) const {
+    rui.fill(out, count, first);
+  }
+  /**
+   * @brief Fills the range with count senary digits as characters.
+   *
+   * @param out the pointer to the first character to fill
+   * @param count the number of digits to generate
+   */
+  void fill_digits(char* out, std::size_t count) const {
+    rui.fill(out, count, static_cast<char>('0' + first));
+  }
+  /**
+   * @brief reseeds the generator with a new seed value
+   *
+   * @param seed the value to seed the generator
+   */
+  void reseed_engine(typename Generator::result_type seed) {
+    rui.reseed_engine(seed);
+  }
 };
 
 /**
@@ -509,32 +1240,34 @@ struct RandomSenary {
  * called it follows the generator and the distribution type that you provide.
  *
  * @tparam std::mt19937 the random number generator to use
- * @tparam std::uniform_int_distribution<unsigned long long> the distribution to
- * use to sample the random number
+ * @tparam distributions::BoundedInteger<unsigned long long> unused, the values
+ * are sampled by StaticRandom from a limit known at compile time
  */
 template <class Generator = std::mt19937,
           class Distribution =
-              std::uniform_int_distribution<unsigned long long>>
+              distributions::BoundedInteger<unsigned long long>>
 class RandomAlphabet {
  private:
-  RandomUnsignedInteger<Generator, Distribution> rui1;
-  RandomUnsignedInteger<Generator, Distribution> rui2;
-  RandomUnsignedInteger<Generator, Distribution> rui3;
+  StaticRandom<limits::StaticUpperCaseAlphabet, Generator> rui1;
+  StaticRandom<limits::StaticLowerCaseAlphabet, Generator> rui2;
+  StaticRandom<limits::StaticAlphabet, Generator> rui3;
 
  public:
   /**
    * @brief Construct a new Random Alphabet object
    *
    */
-  RandomAlphabet()
-      : rui1(RandomUnsignedInteger<Generator, Distribution>(
-            testcaser::maker::RandomCharacterLimit::
-                upper_case_alphabet_limit())),
-        rui2(RandomUnsignedInteger<Generator, Distribution>(
-            testcaser::maker::RandomCharacterLimit::
-                lower_case_alphabet_limit())),
-        rui3(RandomUnsignedInteger<Generator, Distribution>(
-            testcaser::maker::RandomCharacterLimit::alphabet_limit())) {}
+  RandomAlphabet() : RandomAlphabet(std::shared_ptr<Generator>()) {}
+  /**
+   * @brief Construct a new Random Alphabet object drawing from a shared
+   * engine. The upper, lower and mixed characters all draw from it.
+   *
+   * @param engine the engine to draw from, a new one is created when empty
+   */
+  explicit RandomAlphabet(std::shared_ptr<Generator> engine)
+      : rui1(share_or_create(engine)),
+        rui2(rui1.share_engine()),
+        rui3(rui1.share_engine()) {}
   /**
    * @brief Get the lower case character
    *
@@ -553,54 +1286,94 @@ class RandomAlphabet {
    * @return char a valid upper or lower character
    */
   char get() const { return static_cast<char>(rui3.get()); }
+  /**
+   * @brief reseeds the generator with a new seed value
+   *
+   * @param seed the value to seed the generator
+   */
+  void reseed_engine(typename Generator::result_type seed) {
+    rui1.reseed_engine(seed);
+  }
 };
 
 /**
  * @brief A Simple UpperCase RandomAlphabet Wrapper
  *
  * @tparam std::mt19937 The Genenerator to use in the sampling
- * @tparam std::uniform_int_distribution<unsigned long long> The Distribution to
+ * @tparam distributions::BoundedInteger<unsigned long long> The Distribution to
  * use in the sampling.
  */
 
 template <class Generator = std::mt19937,
           class Distribution =
-              std::uniform_int_distribution<unsigned long long>>
+              distributions::BoundedInteger<unsigned long long>>
 class RandomUpperAlphabet {
   RandomAlphabet<Generator, Distribution> rui1;
 
  public:
   RandomUpperAlphabet() : rui1(RandomAlphabet<Generator, Distribution>()){};
+  /**
+   * @brief Construct a new Random Upper Alphabet object drawing from a shared
+   * engine
+   *
+   * @param engine the engine to draw from, a new one is created when empty
+   */
+  explicit RandomUpperAlphabet(std::shared_ptr<Generator> engine)
+      : rui1(engine) {}
   /**
    * @brief Gets a new Random Upper Case Alphabet
    *
    * @return char The Upper Case Alphabet Value
    */
   char get() const { return static_cast<char>(rui1.get_upper()); }
+  /**
+   * @brief reseeds the generator with a new seed value
+   *
+   * @param seed the value to seed the generator
+   */
+  void reseed_engine(typename Generator::result_type seed) {
+    rui1.reseed_engine(seed);
+  }
 };
 
 /**
  * @brief A Simple LowerCase RandomAlphabet Wrapper
  *
  * @tparam std::mt19937 The Genenerator to use in the generation.
- * @tparam std::uniform_int_distribution<unsigned long long> The Distribution to
+ * @tparam distributions::BoundedInteger<unsigned long long> The Distribution to
  * use in the sampling.
  */
 
 template <class Generator = std::mt19937,
           class Distribution =
-              std::uniform_int_distribution<unsigned long long>>
+              distributions::BoundedInteger<unsigned long long>>
 class RandomLowerAlphabet {
   RandomAlphabet<Generator, Distribution> rui1;
 
  public:
   RandomLowerAlphabet() : rui1(RandomAlphabet<Generator, Distribution>()){};
+  /**
+   * @brief Construct a new Random Lower Alphabet object drawing from a shared
+   * engine
+   *
+   * @param engine the engine to draw from, a new one is created when empty
+   */
+  explicit RandomLowerAlphabet(std::shared_ptr<Generator> engine)
+      : rui1(engine) {}
   /**
    * @brief Gets a new Random Lower Case Alphabet
    *
    * @return char The Lower Case Alphabet Value
    */
   char get() const { return static_cast<char>(rui1.get_lower()); }
+  /**
+   * @brief reseeds the generator with a new seed value
+   *
+   * @param seed the value to seed the generator
+   */
+  void reseed_engine(typename Generator::result_type seed) {
+    rui1.reseed_engine(seed);
+  }
 };
 /**
  * @brief RandomFrom object picks a random object from given collection every
@@ -608,12 +1381,12 @@ class RandomLowerAlphabet {
  * you provide.
  *
  * @tparam std::mt19937 the random number generator to use
- * @tparam std::uniform_int_distribution<unsigned long long> the distribution to
+ * @tparam distributions::BoundedInteger<unsigned long long> the distribution to
  * use to sample the random number
  */
 template <class T, class Generator = std::mt19937,
           class Distribution =
-              std::uniform_int_distribution<unsigned long long>>
+              distributions::BoundedInteger<unsigned long long>>
 struct RandomFrom {
   /**
    * @brief data the collection from where the samples will be drawn
@@ -635,19 +1408,403 @@ struct RandomFrom {
    * @brief Construct a new Random From object
    *
    * @param collection the collection as a vector
+   * @param engine the engine to draw from, a new one is created when empty
    */
   // cppcheck-suppress noExplicitConstructor
   // cppcheck-suppress passedByValue
-  RandomFrom(std::vector<T> collection)
+  RandomFrom(std::vector<T> collection,
+             std::shared_ptr<Generator> engine = nullptr)
       : data(collection),
         limit({collection.size(), 0}),
-        _rui(RandomUnsignedInteger<Generator, Distribution>{limit}) {}
+        _rui(RandomUnsignedInteger<Generator, Distribution>{limit, engine}) {}
   /**
    * @brief returns a randomly picked random object from the collection
    *
    * @return T an object of the collection
    */
   T get() const { return data[_rui.get()]; }
+  /**
+   * @brief reseeds the generator with a new seed value
+   *
+   * @param seed the value to seed the generator
+   */
+  void reseed_engine(typename Generator::result_type seed) {
+    _rui.reseed_engine(seed);
+  }
+  /**
+   * @brief Get the engine the indices are drawn with.
+   *
+   * @return Generator& the engine
+   */
+  Generator& get_engine() { return _rui.get_engine(); }
+  /**
+   * @brief Fills the range with count randomly picked objects of the
+   * collection. The indices are drawn in batches with _rui.fill(..)
+   *
+   * @param out the pointer to the first object to fill
+   * @param count the number of objects to pick
+   */
+  void fill(T* out, std::size_t count) const {
+    unsigned long long index[64];
+    while (count > 0) {
+      std::size_t const batch = count < 64 ? count : 64;
+      _rui.fill(index, batch);
+      for (std::size_t t = 0; t < batch; t++) out[t] = data[index[t]];
+      out += batch;
+      count -= batch;
+    }
+  }
+};
+/**
+ * @brief RandomFromView object picks a random object from a collection it
+ * does not copy every time .get() is called. The collection is either a span
+ * of memory that must outlive the object, or an immutable pool shared by any
+ * number of objects and kept alive by them.
+ *
+ * @tparam T the type of the objects of the collection
+ * @tparam std::mt19937 the random number generator to use
+ * @tparam distributions::BoundedInteger<unsigned long long> the distribution to
+ * use to sample the index
+ */
+template <class T, class Generator = std::mt19937,
+          class Distribution =
+              distributions::BoundedInteger<unsigned long long>>
+class RandomFromView {
+  // keeps a shared pool alive, it is empty for a span
+  std::shared_ptr<std::vector<T> const> pool;
+  T const* first;
+  std::size_t count;
+  mutable Distribution dist;
+  RandomType<Generator, Distribution> rt;
+
+  static std::size_t checked(std::size_t size) {
+    if (size == 0) {
+      throw testcaser::exceptions::maker::LimitError(
+          "Cannot pick random objects from an empty collection");
+    }
+    return size;
+  }
+
+ public:
+  /**
+   * @brief Construct a new Random From View object over a span. The span is
+   * not copied and must outlive this object.
+   *
+   * @param data the first object of the span
+   * @param size the number of objects of the span
+   * @param engine the engine to draw from, a new one is created when empty
+   */
+  RandomFromView(T const* data, std::size_t size,
+                 std::shared_ptr<Generator> engine = nullptr)
+      : first(data),
+        count(checked(size)),
+        dist(0, count - 1),
+        rt(share_or_create(engine)) {}
+  /**
+   * @brief Construct a new Random From View object over a shared pool. The
+   * pool is not copied, it lives as long as an object drawing from it.
+   *
+   * @param shared the pool of objects
+   * @param engine the engine to draw from, a new one is created when empty
+   */
+  explicit RandomFromView(std::shared_ptr<std::vector<T> const> shared,
+                          std::shared_ptr<Generator> engine = nullptr)
+      : pool(std::move(shared)),
+        first(pool->data()),
+        count(checked(pool->size())),
+        dist(0, count - 1),
+        rt(share_or_create(engine)) {}
+  /**
+   * @brief returns a randomly picked object of the collection
+   *
+   * @return T const& an object of the collection
+   */
+  T const& get() const { return first[rt.get(dist)]; }
+  /**
+   * @brief Fills the range with count randomly picked objects of the
+   * collection. The indices are drawn in batches.
+   *
+   * @param out the pointer to the first object to fill
+   * @param size the number of objects to pick
+   */
+  void fill(T* out, std::size_t size) const {
+    unsigned long long index[64];
+    while (size > 0) {
+      std::size_t const batch = size < 64 ? size : 64;
+      rt.fill(dist, index, batch);
+      for (std::size_t t = 0; t < batch; t++) out[t] = first[index[t]];
+      out += batch;
+      size -= batch;
+    }
+  }
+  /**
+   * @brief The number of objects of the collection.
+   *
+   * @return std::size_t the number of objects
+   */
+  std::size_t size() const { return count; }
+  /**
+   * @brief reseeds the generator with a new seed value
+   *
+   * @param seed the value to seed the generator
+   */
+  void reseed_engine(typename Generator::result_type seed) {
+    rt.seed_value(seed);
+  }
+  /**
+   * @brief Get the engine the objects are drawn with.
+   *
+   * @return Generator& the engine
+   */
+  Generator& get_engine() { return rt.get_engine(); }
+  /**
+   * @brief Get the engine of this object to share it with other random types.
+   *
+   * @return std::shared_ptr<Generator> the engine
+   */
+  std::shared_ptr<Generator> share_engine() const { return rt.share_engine(); }
+};
+
+/**
+ * @brief RandomWeightedFrom object picks an object of the collection with a
+ * probability proportional to its weight every time .get() is called. It
+ * samples in O(1) from an alias table of Walker built with the method of
+ * Vose: an index is drawn uniformly and is kept or swapped for its alias
+ * after a draw of 32 bits. The weights are also kept in a tree of sums, where
+ * changing a weight costs O(log n) and marks the table as stale. Until as many
+ * objects as the collection holds have been drawn since the last change, the
+ * draws descend the tree in O(log n); the table is rebuilt in O(n) after that.
+ * Interleaving changes and draws thus never rebuilds the table, and a rebuild
+ * is paid for by the draws before it.
+ *
+ * get() and fill() are const but not thread safe: they advance the engine and,
+ * after a weight change, may rebuild the table.
+ *
+ * @tparam T the type of the objects of the collection
+ * @tparam std::mt19937 the random number generator to use
+ * @tparam distributions::BoundedInteger<unsigned long long> the distribution to
+ * use to sample the index
+ */
+template <class T, class Generator = std::mt19937,
+          class Distribution =
+              distributions::BoundedInteger<unsigned long long>>
+class RandomWeightedFrom {
+  std::vector<T> data;
+  std::vector<double> weights;
+  // the alias table. The drawn index is kept when 32 random bits are below
+  // keep[index], alias[index] is picked otherwise.
+  mutable std::vector<std::uint64_t> keep;
+  mutable std::vector<std::size_t> alias;
+  mutable bool stale = true;
+  // the draws made from the tree since the last change
+  mutable std::size_t draws = 0;
+  // the tree of sums: sums[leaves + t] is weights[t], a node is the sum of
+  // its two children and sums[1] the total
+  std::vector<double> sums;
+  std::size_t leaves = 1;
+  mutable Distribution dist;
+  RandomType<Generator, Distribution> rt;
+
+  static void validate(double weight) {
+    if (!(weight >= 0) || weight == std::numeric_limits<double>::infinity()) {
+      throw testcaser::exceptions::maker::WeightError(
+          "Weight " + std::to_string(weight) +
+          " is not a finite non-negative number");
+    }
+  }
+  static void validate_total(double total) {
+    if (!(total > 0)) {
+      throw testcaser::exceptions::maker::WeightError(
+          "The weights of the collection add up to " + std::to_string(total) +
+          ", atleast one weight must be positive");
+    }
+  }
+  void plant() {
+    while (leaves < weights.size()) leaves *= 2;
+    sums.assign(2 * leaves, 0);
+    std::copy(weights.begin(), weights.end(), sums.begin() + leaves);
+    for (std::size_t node = leaves - 1; node > 0; node--)
+      sums[node] = sums[2 * node] + sums[2 * node + 1];
+  }
+  void rebuild() const {
+    std::size_t const n = weights.size();
+    double total = 0;
+    for (double weight : weights) total += weight;
+    validate_total(total);
+    std::vector<double> scaled(n);
+    std::vector<std::size_t> small, large;
+    for (std::size_t t = 0; t < n; t++) {
+      scaled[t] = weights[t] * static_cast<double>(n) / total;
+      (scaled[t] < 1 ? small : large).push_back(t);
+    }
+    keep.assign(n, 0x100000000ull);
+    alias.resize(n);
+    for (std::size_t t = 0; t < n; t++) alias[t] = t;
+    while (!small.empty() && !large.empty()) {
+      std::size_t const less = small.back(), more = large.back();
+      small.pop_back();
+      large.pop_back();
+      keep[less] = static_cast<std::uint64_t>(scaled[less] * 4294967296.0);
+      alias[less] = more;
+      scaled[more] = (scaled[more] + scaled[less]) - 1;
+      (scaled[more] < 1 ? small : large).push_back(more);
+    }
+    // the rest is left at probability 1 to absorb the rounding errors
+    stale = false;
+    draws = 0;
+  }
+  /**
+   * @brief Draws an index from the tree of sums. A node is recomputed from its
+   * children on every change, so a subtree of zero weights sums to exactly 0
+   * and is never entered, a rounding that still ends on one is redrawn.
+   *
+   */
+  std::size_t descend() const {
+    double const total = sums[1];
+    validate_total(total);
+    for (;;) {
+      double target = distributions::Bits::unit(rt.get_engine()) * total;
+      if (!(target < total)) continue;
+      std::size_t node = 1;
+      while (node < leaves) {
+        node *= 2;
+        if (!(target < sums[node])) target -= sums[node++];
+      }
+      if (weights[node - leaves] > 0) return node - leaves;
+    }
+  }
+  std::size_t pick(std::size_t index) const {
+    return distributions::Bits::draw32(rt.get_engine()) < keep[index]
+               ? index
+               : alias[index];
+  }
+
+ public:
+  /**
+   * @brief Construct a new Random Weighted From object
+   *
+   * @param collection the collection as a vector
+   * @param weight the weight of every object of the collection
+   * @param engine the engine to draw from, a new one is created when empty
+   */
+  // cppcheck-suppress passedByValue
+  RandomWeightedFrom(std::vector<T> collection, std::vector<double> weight,
+                     std::shared_ptr<Generator> engine = nullptr)
+      : data(std::move(collection)),
+        weights(std::move(weight)),
+        dist(0, data.empty() ? 0 : data.size() - 1),
+        rt(share_or_create(engine)) {
+    if (data.empty() || data.size() != weights.size()) {
+      throw testcaser::exceptions::maker::WeightError(
+          "Expected one weight for each of the " +
+          std::to_string(data.size()) + " objects of a non empty collection, " +
+          std::to_string(weights.size()) + " weights were given");
+    }
+    for (double value : weights) validate(value);
+    this->plant();
+    this->rebuild();
+  }
+  /**
+   * @brief returns a randomly picked object of the collection. Not thread
+   * safe, see the class.
+   *
+   * @return T an object of the collection
+   */
+  T get() const {
+    if (stale && draws >= weights.size()) this->rebuild();
+    if (stale) {
+      draws++;
+      return data[this->descend()];
+    }
+    return data[this->pick(static_cast<std::size_t>(rt.get(dist)))];
+  }
+  /**
+   * @brief Fills the range with count randomly picked objects of the
+   * collection. The indices are drawn in batches before their aliases.
+   *
+   * @param out the pointer to the first object to fill
+   * @param count the number of objects to pick
+   */
+  void fill(T* out, std::size_t count) const {
+    if (stale && draws + count >= weights.size()) this->rebuild();
+    if (stale) {
+      for (std::size_t t = 0; t < count; t++) out[t] = data[this->descend()];
+      draws += count;
+      return;
+    }
+    unsigned long long index[64];
+    while (count > 0) {
+      std::size_t const batch = count < 64 ? count : 64;
+      rt.fill(dist, index, batch);
+      for (std::size_t t = 0; t < batch; t++)
+        out[t] = data[this->pick(static_cast<std::size_t>(index[t]))];
+      out += batch;
+      count -= batch;
+    }
+  }
+  /**
+   * @brief Get the weight of an object.
+   *
+   * @param index the index of the object in the collection
+   * @return double the weight
+   */
+  double weight(std::size_t index) const { return weights.at(index); }
+  /**
+   * @brief Changes the weight of an object in O(log n). The next draws use the
+   * tree of sums until the alias table is worth rebuilding.
+   *
+   * @param index the index of the object in the collection
+   * @param value the new weight
+   */
+  void set_weight(std::size_t index, double value) {
+    validate(value);
+    weights.at(index) = value;
+    std::size_t node = leaves + index;
+    sums[node] = value;
+    for (node /= 2; node > 0; node /= 2)
+      sums[node] = sums[2 * node] + sums[2 * node + 1];
+    stale = true;
+    draws = 0;
+  }
+  /**
+   * @brief Changes the weights of all the objects in O(n). The alias table is
+   * rebuilt as after set_weight().
+   *
+   * @param value the new weights, one for each object
+   */
+  // cppcheck-suppress passedByValue
+  void set_weights(std::vector<double> value) {
+    if (value.size() != data.size()) {
+      throw testcaser::exceptions::maker::WeightError(
+          "Expected " + std::to_string(data.size()) + " weights, " +
+          std::to_string(value.size()) + " were given");
+    }
+    for (double item : value) validate(item);
+    weights = std::move(value);
+    this->plant();
+    stale = true;
+    draws = 0;
+  }
+  /**
+   * @brief reseeds the generator with a new seed value
+   *
+   * @param seed the value to seed the generator
+   */
+  void reseed_engine(typename Generator::result_type seed) {
+    rt.seed_value(seed);
+  }
+  /**
+   * @brief Get the engine the objects are drawn with.
+   *
+   * @return Generator& the engine
+   */
+  Generator& get_engine() { return rt.get_engine(); }
+  /**
+   * @brief Get the engine of this object to share it with other random types.
+   *
+   * @return std::shared_ptr<Generator> the engine
+   */
+  std::shared_ptr<Generator> share_engine() const { return rt.share_engine(); }
 };
 // ? As far as float/double is concerned it should be generated via
 // ? RandomIntegers. We do not wish to add separate object for it as of now.
@@ -0,0 +1,286 @@
+/**
+ *   Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+#ifndef CORPUS_HPP
+#define CORPUS_HPP
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <testcaser/core/exceptions/BuildException.hpp>
+#include <testcaser/core/maker/randoms/RandomTypes.hpp>
+#include <utility>
+#include <vector>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace testcaser {
+namespace maker {
+/**
+ * @brief A token of a Corpus. It points into the memory of the corpus and is
+ * valid as long as the corpus is.
+ *
+ */
+struct Token {
+  /**
+   * @brief text the first character of the token, it is not null terminated
+   *
+   */
+  char const* text;
+  /**
+   * @brief length the number of characters of the token
+   *
+   */
+  std::size_t length;
+  /**
+   * @brief Copies the token into a string.
+   *
+   * @return std::string the token
+   */
+  std::string str() const { return std::string(text, length); }
+  /**
+   * @brief Two tokens are equal when they have the same characters.
+   *
+   */
+  bool operator==(Token const& other) const {
+    return length == other.length && std::equal(text, text + length, other.text);
+  }
+};
+
+/**
+ * @brief Writes the characters of the token to the stream.
+ *
+ */
+inline std::ostream& operator<<(std::ostream& out, Token const& token) {
+  return out.write(token.text, static_cast<std::streamsize>(token.length));
+}
+
+/**
+ * @brief A corpus of tokens, one per line of a file, like a dictionary of
+ * words. The file is mapped in memory read only and indexed once with the
+ * start and end of every token, so that a token is found in O(1) and a corpus
+ * of hundreds of megabytes is never copied. Empty lines are skipped and a
+ * "\r" ending a line is not part of its token. Share a corpus between random
+ * objects through a std::shared_ptr<Corpus const>.
+ *
+ */
+class Corpus {
+  std::string path;
+  char const* base = nullptr;
+  std::size_t length = 0;
+  // the contents of the file where it cannot be mapped
+  std::vector<char> contents;
+  // the start and end offsets of every token
+  std::vector<std::pair<std::size_t, std::size_t>> spans;
+
+  void fail(std::string const& action) {
+    throw testcaser::exceptions::maker::CorpusIOError(
+        action + " " + path + " failed : " + strerror(errno));
+  }
+  void load() {
+#ifndef _WIN32
+    int const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) this->fail("Opening");
+    struct stat status;
+    if (::fstat(fd, &status) != 0) {
+      int const reason = errno;
+      ::close(fd);
+      errno = reason;
+      this->fail("Reading the size of");
+    }
+    length = static_cast<std::size_t>(status.st_size);
+    if (length > 0) {
+      void* memory = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+      int const reason = errno;
+      ::close(fd);
+      errno = reason;
+      if (memory == MAP_FAILED) this->fail("Mapping");
+      base = static_cast<char const*>(memory);
+      return;
+    }
+    ::close(fd);
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file) this->fail("Opening");
+    contents.assign(std::istreambuf_iterator<char>(file),
+                    std::istreambuf_iterator<char>());
+    base = contents.data();
+    length = contents.size();
+#endif
+  }
+  void index() {
+#if !defined(_WIN32) && defined(MADV_SEQUENTIAL)
+    if (length > 0)
+      ::madvise(const_cast<char*>(base), length, MADV_SEQUENTIAL);
+#endif
+    std::size_t start = 0;
+    while (start < length) {
+      char const* end = static_cast<char const*>(
+          memchr(base + start, '\n', length - start));
+      std::size_t const stop =
+          end == nullptr ? length : static_cast<std::size_t>(end - base);
+      std::size_t token_end = stop;
+      if (token_end > start && base[token_end - 1] == '\r') token_end--;
+      if (token_end > start) spans.emplace_back(start, token_end);
+      start = stop + 1;
+    }
+    // the tokens are then read in random order
+#if !defined(_WIN32) && defined(MADV_RANDOM)
+    if (length > 0) ::madvise(const_cast<char*>(base), length, MADV_RANDOM);
+#endif
+  }
+
+ public:
+  Corpus(Corpus const&) = delete;
+  Corpus& operator=(Corpus const&) = delete;
+  /**
+   * @brief Construct a new Corpus object from a file of one token per line.
+   * Throws CorpusIOError when the file cannot be read.
+   *
+   * @param abs_name the path of the file
+   */
+  explicit Corpus(std::string const& abs_name) : path(abs_name) {
+    this->load();
+    this->index();
+  }
+  /**
+   * @brief The number of tokens.
+   *
+   * @return std::size_t the number of tokens
+   */
+  std::size_t size() const { return spans.size(); }
+  /**
+   * @brief The token at an index.
+   *
+   * @param at the index of the token, less than size()
+   * @return Token the token
+   */
+  Token operator[](std::size_t at) const {
+    return Token{base + spans[at].first, spans[at].second - spans[at].first};
+  }
+  /**
+   * @brief The path of the file.
+   *
+   * @return std::string the path
+   */
+  std::string name() const { return path; }
+  /**
+   * @brief Destroy the Corpus object and unmaps the file.
+   *
+   */
+  ~Corpus() {
+#ifndef _WIN32
+    if (base != nullptr) ::munmap(const_cast<char*>(base), length);
+#endif
+  }
+};
+
+namespace types {
+/**
+ * @brief RandomToken object picks a random token of a Corpus every time
+ * .get() is called. The corpus is shared, never copied, and lives as long as
+ * an object drawing from it.
+ *
+ * @tparam std::mt19937 the random number generator to use
+ * @tparam distributions::BoundedInteger<unsigned long long> the distribution to
+ * use to sample the index
+ */
+template <class Generator = std::mt19937,
+          class Distribution =
+              distributions::BoundedInteger<unsigned long long>>
+class RandomToken {
+  std::shared_ptr<Corpus const> corpus;
+  mutable Distribution dist;
+  RandomType<Generator, Distribution> rt;
+
+  static std::size_t checked(Corpus const& tokens) {
+    if (tokens.size() == 0) {
+      throw testcaser::exceptions::maker::LimitError(
+          "Cannot pick random tokens from the empty corpus " + tokens.name());
+    }
+    return tokens.size();
+  }
+
+ public:
+  /**
+   * @brief Construct a new Random Token object
+   *
+   * @param shared the corpus to pick the tokens from
+   * @param engine the engine to draw from, a new one is created when empty
+   */
+  explicit RandomToken(std::shared_ptr<Corpus const> shared,
+                       std::shared_ptr<Generator> engine = nullptr)
+      : corpus(std::move(shared)),
+        dist(0, checked(*corpus) - 1),
+        rt(share_or_create(engine)) {}
+  /**
+   * @brief returns a randomly picked token
+   *
+   * @return Token the token
+   */
+  Token get() const { return (*corpus)[rt.get(dist)]; }
+  /**
+   * @brief Fills the range with count randomly picked tokens. The indices are
+   * drawn in batches.
+   *
+   * @param out the pointer to the first token to fill
+   * @param count the number of tokens to pick
+   */
+  void fill(Token* out, std::size_t count) const {
+    unsigned long long index[64];
+    while (count > 0) {
+      std::size_t const batch = count < 64 ? count : 64;
+      rt.fill(dist, index, batch);
+      for (std::size_t t = 0; t < batch; t++) out[t] = (*corpus)[index[t]];
+      out += batch;
+      count -= batch;
+    }
+  }
+  /**
+   * @brief reseeds the generator with a new seed value
+   *
+   * @param seed the value to seed the generator
+   */
+  void reseed_engine(typename Generator::result_type seed) {
+    rt.seed_value(seed);
+  }
+  /**
+   * @brief Get the engine the tokens are drawn with.
+   *
+   * @return Generator& the engine
+   */
+  Generator& get_engine() { return rt.get_engine(); }
+  /**
+   * @brief Get the engine of this object to share it with other random types.
+   *
+   * @return std::shared_ptr<Generator> the engine
+   */
+  std::shared_ptr<Generator> share_engine() const { return rt.share_engine(); }
+};
+}  // namespace types
+}  // namespace maker
+}  // namespace testcaser
+#endif
@@ -0,0 +1,796 @@
+/**
+ *   Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef DISTRIBUTIONS_HPP
+#define DISTRIBUTIONS_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <testcaser/core/exceptions/InvalidLimit.hpp>
+#include <testcaser/core/maker/randoms/engines.hpp>
+
+namespace testcaser {
+namespace maker {
+/**
+ * @brief The namespace that holds the distributions shipped with the maker.
+ * Unlike the distributions of the standard library their output is fully
+ * specified, so a seed generates the same test with every compiler.
+ *
+ */
+namespace distributions {
+/**
+ * @brief Draws uniformly distributed bits from any engine. Engines generating
+ * 32 or 64 bits per call are used as they are, the values of other engines
+ * are cut to their largest power of two with rejection.
+ *
+ */
+struct Bits {
+  /**
+   * @brief Does the engine generate 32 uniform bits per call.
+   *
+   */
+  template <class Engine>
+  static bool is_32_bit() {
+    return static_cast<std::uint64_t>(Engine::max() - Engine::min()) ==
+           0xFFFFFFFFull;
+  }
+  /**
+   * @brief Does the engine generate 64 uniform bits per call.
+   *
+   */
+  template <class Engine>
+  static bool is_64_bit() {
+    return static_cast<std::uint64_t>(Engine::max() - Engine::min()) ==
+           ~0ull;
+  }
+  /**
+   * @brief Draws count uniform bits, count being atmost 64.
+   *
+   */
+  template <class Engine>
+  static std::uint64_t draw(Engine& engine, int count) {
+    std::uint64_t const range =
+        static_cast<std::uint64_t>(Engine::max() - Engine::min());
+    // the values below the highest power of two of the range are all used
+    int usable = 63;
+    while (usable > 0 && (range >> usable) == 0) usable--;
+    if ((range & (range + 1)) == 0) usable++;
+    std::uint64_t out = 0;
+    for (int have = 0; have < count;) {
+      std::uint64_t value =
+          static_cast<std::uint64_t>(engine() - Engine::min());
+      if ((value >> usable) != 0) continue;
+      int const take = count - have < usable ? count - have : usable;
+      out = take == 64 ? value : (out << take) | (value & ((1ull << take) - 1));
+      have += take;
+    }
+    return out;
+  }
+  /**
+   * @brief Draws 32 uniform bits.
+   *
+   */
+  template <class Engine>
+  static std::uint32_t draw32(Engine& engine) {
+    if (is_32_bit<Engine>() || is_64_bit<Engine>())
+      return static_cast<std::uint32_t>(engine() - Engine::min());
+    return static_cast<std::uint32_t>(draw(engine, 32));
+  }
+  /**
+   * @brief Draws 64 uniform bits. Engines of 32 bits are called twice, the
+   * first value giving the high bits.
+   *
+   */
+  template <class Engine>
+  static std::uint64_t draw64(Engine& engine) {
+    if (is_64_bit<Engine>())
+      return static_cast<std::uint64_t>(engine() - Engine::min());
+    if (is_32_bit<Engine>()) {
+      std::uint64_t const high = static_cast<std::uint64_t>(engine() - Engine::min());
+      return (high << 32) | static_cast<std::uint64_t>(engine() - Engine::min());
+    }
+    return draw(engine, 64);
+  }
+  /**
+   * @brief Draws count times 64 uniform bits. Engines of 64 bits having a
+   * bulk fill(..), like engines::Xoshiro256x4, generate them all at once.
+   *
+   */
+  template <class Engine>
+  static void fill64(Engine& engine, std::uint64_t* out, std::size_t count) {
+    if (is_64_bit<Engine>())
+      Bits::fill64(engine, out, count, 0);
+    else
+      for (std::size_t t = 0; t < count; t++) out[t] = draw64(engine);
+  }
+  /**
+   * @brief Draws a uniform real of [0, 1) from the 53 high bits of a 64 bit
+   * draw.
+   *
+   */
+  template <class Engine>
+  static double unit(Engine& engine) {
+    return static_cast<double>(draw64(engine) >> 11) *
+           (1.0 / 9007199254740992.0);
+  }
+  /**
+   * @brief Draws a uniform real of (0, 1], which can be passed to std::log.
+   *
+   */
+  template <class Engine>
+  static double open_unit(Engine& engine) {
+    return 1.0 - unit(engine);
+  }
+
+ private:
+  template <class Engine>
+  static auto fill64(Engine& engine, std::uint64_t* out, std::size_t count,
+                     int) -> decltype(engine.fill(out, count), void()) {
+    engine.fill(out, count);
+  }
+  template <class Engine>
+  static void fill64(Engine& engine, std::uint64_t* out, std::size_t count,
+                     long) {
+    for (std::size_t t = 0; t < count; t++) out[t] = draw64(engine);
+  }
+};
+
+/**
+ * @brief A uniform distribution over the integers of [a, b], drawn with the
+ * nearly divisionless method of Lemire. The rejection threshold of the range
+ * is computed once when the distribution is constructed, so a draw costs one
+ * multiplication and almost never a division. It can be used wherever a
+ * std::uniform_int_distribution is used.
+ *
+ * @tparam T the integer type to generate
+ */
+template <class T>
+class BoundedInteger {
+  T lower, upper;
+  // the size of the range minus one, the range covers all 64 bit values when
+  // it is ~0
+  std::uint64_t span;
+  std::uint64_t threshold64;
+  std::uint32_t threshold32;
+
+  T shift(std::uint64_t offset) const {
+    return static_cast<T>(static_cast<std::uint64_t>(lower) + offset);
+  }
+
+ public:
+  /**
+   * @brief The type of the values generated.
+   *
+   */
+  typedef T result_type;
+  /**
+   * @brief Construct a new Bounded Integer object
+   *
+   * @param a the smallest value to generate
+   * @param b the largest value to generate
+   */
+  explicit BoundedInteger(T a = 0, T b = static_cast<T>(~0ull >> 1))
+      : lower(a), upper(b) {
+    span = static_cast<std::uint64_t>(b) - static_cast<std::uint64_t>(a);
+    std::uint64_t const size = span + 1;
+    threshold64 = size == 0 ? 0 : (0 - size) % size;
+    threshold32 = span >= 0xFFFFFFFFull
+                      ? 0
+                      : static_cast<std::uint32_t>((0x100000000ull - size) %
+                                                   size);
+  }
+  /**
+   * @brief Generates a value of [a, b] from the bits of the engine.
+   *
+   * @param engine the engine to draw the bits from
+   * @return T the value
+   */
+  template <class Engine>
+  T operator()(Engine& engine) const {
+    if (span == ~0ull) return this->shift(Bits::draw64(engine));
+    if (span <= 0xFFFFFFFFull && !Bits::is_64_bit<Engine>()) {
+      if (span == 0xFFFFFFFFull) return this->shift(Bits::draw32(engine));
+      std::uint32_t const size = static_cast<std::uint32_t>(span + 1);
+      std::uint64_t product =
+          static_cast<std::uint64_t>(Bits::draw32(engine)) * size;
+      if (static_cast<std::uint32_t>(product) < size) {
+        while (static_cast<std::uint32_t>(product) < threshold32)
+          product = static_cast<std::uint64_t>(Bits::draw32(engine)) * size;
+      }
+      return this->shift(product >> 32);
+    }
+    std::uint64_t const size = span + 1;
+    engines::wide::uint128 product =
+        engines::wide::multiply(Bits::draw64(engine), size);
+    if (engines::wide::low(product) < size) {
+      while (engines::wide::low(product) < threshold64)
+        product = engines::wide::multiply(Bits::draw64(engine), size);
+    }
+    return this->shift(engines::wide::high(product));
+  }
+  /**
+   * @brief Generates count values of [a, b], the same values as count calls
+   * of operator(). The bits of a batch are drawn at once and reduced in a loop
+   * without branches, which the compiler vectorizes for ranges of atmost 2^32
+   * values. When a value of the batch is rejected, the batch is finished one
+   * value at a time from the rejected one on, using the bits already drawn
+   * before drawing new ones.
+   *
+   * @param engine the engine to draw the bits from
+   * @param out the values
+   * @param count the number of values
+   */
+  template <class Engine>
+  void fill(Engine& engine, T* out, std::size_t count) const {
+    std::uint64_t raw[64];
+    while (count > 0) {
+      std::size_t const batch = count < 64 ? count : 64;
+      if (span == ~0ull) {
+        Bits::fill64(engine, raw, batch);
+        for (std::size_t t = 0; t < batch; t++) out[t] = this->shift(raw[t]);
+      } else if (span <= 0xFFFFFFFFull && !Bits::is_64_bit<Engine>()) {
+        for (std::size_t t = 0; t < batch; t++) raw[t] = Bits::draw32(engine);
+        std::uint64_t const size = span + 1;
+        std::size_t rejected = batch;
+        if (span < 0xFFFFFFFFull) {
+          for (std::size_t t = 0; t < batch; t++)
+            out[t] = this->shift((raw[t] * size) >> 32);
+          for (std::size_t t = 0; t < batch && rejected == batch; t++)
+            if (static_cast<std::uint32_t>(raw[t] * size) < threshold32)
+              rejected = t;
+        } else {
+          for (std::size_t t = 0; t < batch; t++) out[t] = this->shift(raw[t]);
+        }
+        for (std::size_t t = rejected, next = rejected; t < batch; t++) {
+          std::uint64_t product;
+          do {
+            product = (next < batch ? raw[next++] : Bits::draw32(engine)) * size;
+          } while (static_cast<std::uint32_t>(product) < threshold32);
+          out[t] = this->shift(product >> 32);
+        }
+      } else {
+        Bits::fill64(engine, raw, batch);
+        std::uint64_t const size = span + 1;
+        std::size_t rejected = batch;
+        for (std::size_t t = 0; t < batch && rejected == batch; t++) {
+          engines::wide::uint128 const product =
+              engines::wide::multiply(raw[t], size);
+          if (engines::wide::low(product) < threshold64)
+            rejected = t;
+          else
+            out[t] = this->shift(engines::wide::high(product));
+        }
+        for (std::size_t t = rejected, next = rejected; t < batch; t++) {
+          engines::wide::uint128 product;
+          do {
+            product = engines::wide::multiply(
+                next < batch ? raw[next++] : Bits::draw64(engine), size);
+          } while (engines::wide::low(product) < threshold64);
+          out[t] = this->shift(engines::wide::high(product));
+        }
+      }
+      out += batch;
+      count -= batch;
+    }
+  }
+  /**
+   * @brief The smallest value generated.
+   *
+   */
+  T a() const { return lower; }
+  /**
+   * @brief The largest value generated.
+   *
+   */
+  T b() const { return upper; }
+  /**
+   * @brief The smallest value generated.
+   *
+   */
+  T min() const { return lower; }
+  /**
+   * @brief The largest value generated.
+   *
+   */
+  T max() const { return upper; }
+  /**
+   * @brief The distribution keeps no state between draws.
+   *
+   */
+  void reset() {}
+};
+
+/**
+ * @brief The ziggurats of the normal and the exponential distributions. The
+ * area under the density is covered by 256 layers of equal area, so that a
+ * draw is accepted by a single comparison about 99% of the time. The tables
+ * follow Marsaglia and Tsang, with the layers of Doornik, and are computed once
+ * on the first draw.
+ *
+ */
+namespace ziggurat {
+/**
+ * @brief The layers of a ziggurat. x[i] is the right edge of layer i and f[i]
+ * the density there, layer 0 being the base holding the tail.
+ *
+ */
+struct Table {
+  /**
+   * @brief x the right edges of the layers
+   *
+   */
+  double x[257];
+  /**
+   * @brief f the density at the right edges
+   *
+   */
+  double f[257];
+  /**
+   * @brief Construct a new Table object
+   *
+   * @param r the start of the tail
+   * @param v the area of every layer
+   * @param density the density, not normalized
+   * @param inverse the inverse of the density
+   */
+  Table(double r, double v, double (*density)(double),
+        double (*inverse)(double)) {
+    x[0] = v / density(r);
+    x[1] = r;
+    for (int i = 2; i < 256; i++) x[i] = inverse(v / x[i - 1] + density(x[i - 1]));
+    x[256] = 0;
+    for (int i = 0; i <= 256; i++) f[i] = density(x[i]);
+  }
+};
+
+inline double normal_density(double x) { return std::exp(-x * x / 2); }
+inline double normal_inverse(double y) { return std::sqrt(-2 * std::log(y)); }
+inline double exponential_density(double x) { return std::exp(-x); }
+inline double exponential_inverse(double y) { return -std::log(y); }
+
+/**
+ * @brief The start of the tail of the normal ziggurat.
+ *
+ */
+constexpr double normal_tail = 3.6541528853610088;
+/**
+ * @brief The start of the tail of the exponential ziggurat.
+ *
+ */
+constexpr double exponential_tail = 7.69711747013104972;
+
+/**
+ * @brief The table of the normal ziggurat.
+ *
+ */
+inline Table const& normal_table() {
+  static Table const table(normal_tail, 0.00492867323399, normal_density,
+                           normal_inverse);
+  return table;
+}
+/**
+ * @brief The table of the exponential ziggurat.
+ *
+ */
+inline Table const& exponential_table() {
+  static Table const table(exponential_tail, 0.0039496598225815571993,
+                           exponential_density, exponential_inverse);
+  return table;
+}
+
+/**
+ * @brief Draws a standard normal value. The layer comes from the 8 low bits
+ * of a draw and the position in it from the 53 high ones.
+ *
+ */
+template <class Engine>
+double normal(Engine& engine) {
+  Table const& table = normal_table();
+  for (;;) {
+    std::uint64_t const bits = Bits::draw64(engine);
+    std::size_t const i = bits & 0xFF;
+    double const u =
+        static_cast<double>(bits >> 11) * (1.0 / 4503599627370496.0) - 1.0;
+    double const x = u * table.x[i];
+    if (std::fabs(x) < table.x[i + 1]) return x;
+    if (i == 0) {
+      // the tail beyond normal_tail, drawn by the method of Marsaglia
+      double tail, y;
+      do {
+        tail = std::log(Bits::open_unit(engine)) / normal_tail;
+        y = std::log(Bits::open_unit(engine));
+      } while (-2 * y < tail * tail);
+      return u < 0 ? tail - normal_tail : normal_tail - tail;
+    }
+    if (table.f[i + 1] + (table.f[i] - table.f[i + 1]) * Bits::unit(engine) <
+        normal_density(x))
+      return x;
+  }
+}
+
+/**
+ * @brief Draws a standard exponential value.
+ *
+ */
+template <class Engine>
+double exponential(Engine& engine) {
+  Table const& table = exponential_table();
+  for (;;) {
+    std::uint64_t const bits = Bits::draw64(engine);
+    std::size_t const i = bits & 0xFF;
+    double const x = static_cast<double>(bits >> 11) *
+                     (1.0 / 9007199254740992.0) * table.x[i];
+    if (x < table.x[i + 1]) return x;
+    // the tail is an exponential shifted by exponential_tail
+    if (i == 0) return exponential_tail - std::log(Bits::open_unit(engine));
+    if (table.f[i + 1] + (table.f[i] - table.f[i + 1]) * Bits::unit(engine) <
+        exponential_density(x))
+      return x;
+  }
+}
+}  // namespace ziggurat
+
+/**
+ * @brief A normal distribution drawn with the ziggurat method.
+ *
+ */
+class Normal {
+  double mu, sigma;
+
+ public:
+  /**
+   * @brief The type of the values generated.
+   *
+   */
+  typedef double result_type;
+  /**
+   * @brief Construct a new Normal object
+   *
+   * @param mean the mean of the values
+   * @param stddev the standard deviation of the values, not negative
+   */
+  explicit Normal(double mean = 0, double stddev = 1)
+      : mu(mean), sigma(stddev) {
+    if (!(stddev >= 0))
+      throw testcaser::exceptions::maker::LimitError(
+          "Standard deviation of a normal distribution cannot be negative, "
+          "it was " +
+          std::to_string(stddev));
+  }
+  /**
+   * @brief Generates a value from the bits of the engine.
+   *
+   */
+  template <class Engine>
+  double operator()(Engine& engine) const {
+    return mu + sigma * ziggurat::normal(engine);
+  }
+  /**
+   * @brief The mean of the values.
+   *
+   */
+  double mean() const { return mu; }
+  /**
+   * @brief The standard deviation of the values.
+   *
+   */
+  double stddev() const { return sigma; }
+  /**
+   * @brief The distribution keeps no state between draws.
+   *
+   */
+  void reset() {}
+};
+
+/**
+ * @brief An exponential distribution drawn with the ziggurat method.
+ *
+ */
+class Exponential {
+  double lambda;
+
+ public:
+  /**
+   * @brief The type of the values generated.
+   *
+   */
+  typedef double result_type;
+  /**
+   * @brief Construct a new Exponential object
+   *
+   * @param rate the rate of the values, their mean is 1 / rate
+   */
+  explicit Exponential(double rate = 1) : lambda(rate) {
+    if (!(rate > 0))
+      throw testcaser::exceptions::maker::LimitError(
+          "Rate of an exponential distribution must be positive, it was " +
+          std::to_string(rate));
+  }
+  /**
+   * @brief Generates a value from the bits of the engine.
+   *
+   */
+  template <class Engine>
+  double operator()(Engine& engine) const {
+    return ziggurat::exponential(engine) / lambda;
+  }
+  /**
+   * @brief The rate of the values.
+   *
+   */
+  double rate() const { return lambda; }
+  /**
+   * @brief The distribution keeps no state between draws.
+   *
+   */
+  void reset() {}
+};
+
+/**
+ * @brief A geometric distribution, the number of failures before the first
+ * success of trials succeeding with probability p. It is drawn by inversion
+ * with a single logarithm.
+ *
+ */
+class Geometric {
+  double success;
+  // 1 / log(1 - p)
+  double scale;
+
+ public:
+  /**
+   * @brief The type of the values generated.
+   *
+   */
+  typedef long long result_type;
+  /**
+   * @brief Construct a new Geometric object
+   *
+   * @param p the probability of a success, in (0, 1]
+   */
+  explicit Geometric(double p = 0.5) : success(p) {
+    if (!(p > 0 && p <= 1))
+      throw testcaser::exceptions::maker::LimitError(
+          "Probability of a geometric distribution must be in (0, 1], it "
+          "was " +
+          std::to_string(p));
+    scale = p == 1 ? 0 : 1 / std::log1p(-p);
+  }
+  /**
+   * @brief Generates a value from the bits of the engine.
+   *
+   */
+  template <class Engine>
+  long long operator()(Engine& engine) const {
+    if (success == 1) return 0;
+    double const k = std::floor(std::log(Bits::open_unit(engine)) * scale);
+    return k >= 9.2233720368547758e18 ? __LONG_LONG_MAX__
+                                      : static_cast<long long>(k);
+  }
+  /**
+   * @brief The probability of a success.
+   *
+   */
+  double p() const { return success; }
+  /**
+   * @brief The distribution keeps no state between draws.
+   *
+   */
+  void reset() {}
+};
+
+/**
+ * @brief A Poisson distribution. Small means are drawn by inversion and means
+ * of 10 and more by the transformed rejection of Hormann (PTRS), whose cost
+ * does not grow with the mean.
+ *
+ */
+class Poisson {
+  double mu;
+  // exp(-mean) for the inversion
+  double start;
+  // the constants of PTRS
+  double b, a, inv_alpha, vr, log_mu;
+
+  static double log_factorial(long long k) {
+    static double const series[10] = {
+        8.333333333333333e-02, -2.777777777777778e-03, 7.936507936507937e-04,
+        -5.952380952380952e-04, 8.417508417508418e-04, -1.917526917526918e-03,
+        6.410256410256410e-03, -2.955065359477124e-02, 1.796443723688307e-01,
+        -1.39243221690590e+00};
+    // log((k)!) = log(gamma(x)) for x = k + 1, by the Stirling series moved
+    // up to x >= 7
+    double const x = static_cast<double>(k) + 1;
+    if (k < 2) return 0;
+    int const n = x < 7 ? static_cast<int>(7 - x) : 0;
+    double x0 = x + n;
+    double const x2 = 1 / (x0 * x0);
+    double sum = series[9];
+    for (int t = 8; t >= 0; t--) sum = sum * x2 + series[t];
+    double result = sum / x0 + 0.9189385332046727 + (x0 - 0.5) * std::log(x0) -
+                    x0;
+    for (int t = 0; t < n; t++) {
+      x0 -= 1;
+      result -= std::log(x0);
+    }
+    return result;
+  }
+
+ public:
+  /**
+   * @brief The type of the values generated.
+   *
+   */
+  typedef long long result_type;
+  /**
+   * @brief Construct a new Poisson object
+   *
+   * @param mean the mean of the values, not negative
+   */
+  explicit Poisson(double mean = 1) : mu(mean) {
+    if (!(mean >= 0 && mean < 1e18))
+      throw testcaser::exceptions::maker::LimitError(
+          "Mean of a poisson distribution must be in [0, 1e18), it was " +
+          std::to_string(mean));
+    start = std::exp(-mean);
+    double const root = std::sqrt(mean);
+    b = 0.931 + 2.53 * root;
+    a = -0.059 + 0.02483 * b;
+    inv_alpha = 1.1239 + 1.1328 / (b - 3.4);
+    vr = 0.9277 - 3.6224 / (b - 2);
+    log_mu = std::log(mean);
+  }
+  /**
+   * @brief Generates a value from the bits of the engine.
+   *
+   */
+  template <class Engine>
+  long long operator()(Engine& engine) const {
+    if (mu < 10) {
+      double u = Bits::unit(engine), p = start;
+      long long k = 0;
+      // the probabilities left may be lost to rounding, they are negligible
+      while (u > p && p > 0) {
+        u -= p;
+        k++;
+        p *= mu / static_cast<double>(k);
+      }
+      return k;
+    }
+    for (;;) {
+      double const u = Bits::unit(engine) - 0.5;
+      double const v = Bits::open_unit(engine);
+      double const us = 0.5 - std::fabs(u);
+      double const k = std::floor((2 * a / us + b) * u + mu + 0.43);
+      if (us >= 0.07 && v <= vr) return static_cast<long long>(k);
+      if (k < 0 || (us < 0.013 && v > us)) continue;
+      if (std::log(v) + std::log(inv_alpha) - std::log(a / (us * us) + b) <=
+          -mu + k * log_mu - log_factorial(static_cast<long long>(k)))
+        return static_cast<long long>(k);
+    }
+  }
+  /**
+   * @brief The mean of the values.
+   *
+   */
+  double mean() const { return mu; }
+  /**
+   * @brief The distribution keeps no state between draws.
+   *
+   */
+  void reset() {}
+};
+
+/**
+ * @brief A Zipf distribution over the ranks 1 ... n, rank k being drawn with
+ * a probability proportional to 1 / k^s. It is drawn by the rejection
+ * inversion of Hormann and Derflinger, which needs no table, so n can be as
+ * large as the keys of a production load, and accepts most draws at once.
+ *
+ */
+class Zipf {
+  long long n;
+  double s;
+  double integral_first, integral_last, squeeze;
+
+  // log1p(x) / x and expm1(x) / x, accurate near 0
+  static double log1p_ratio(double x) {
+    return std::fabs(x) > 1e-8 ? std::log1p(x) / x
+                               : 1 - x * (0.5 - x * (1.0 / 3 - 0.25 * x));
+  }
+  static double expm1_ratio(double x) {
+    return std::fabs(x) > 1e-8 ? std::expm1(x) / x
+                               : 1 + x * 0.5 * (1 + x / 3 * (1 + 0.25 * x));
+  }
+  // h(x) = x^-s, H its integral and H^-1 the inverse of H
+  double h(double x) const { return std::exp(-s * std::log(x)); }
+  double integral(double x) const {
+    double const log_x = std::log(x);
+    return expm1_ratio((1 - s) * log_x) * log_x;
+  }
+  double integral_inverse(double x) const {
+    double t = x * (1 - s);
+    if (t < -1) t = -1;
+    return std::exp(log1p_ratio(t) * x);
+  }
+
+ public:
+  /**
+   * @brief The type of the values generated.
+   *
+   */
+  typedef long long result_type;
+  /**
+   * @brief Construct a new Zipf object
+   *
+   * @param count the number of ranks n
+   * @param exponent the exponent s, positive
+   */
+  explicit Zipf(long long count = 1, double exponent = 1)
+      : n(count), s(exponent) {
+    if (count < 1 || !(exponent > 0))
+      throw testcaser::exceptions::maker::LimitError(
+          "Zipf distribution needs atleast one rank and a positive exponent, "
+          "it was given " +
+          std::to_string(count) + " ranks and exponent " +
+          std::to_string(exponent));
+    integral_first = this->integral(1.5) - 1;
+    integral_last = this->integral(static_cast<double>(n) + 0.5);
+    squeeze =
+        2 - this->integral_inverse(this->integral(2.5) - this->h(2));
+  }
+  /**
+   * @brief Generates a rank from the bits of the engine.
+   *
+   */
+  template <class Engine>
+  long long operator()(Engine& engine) const {
+    for (;;) {
+      double const u = integral_last +
+                       Bits::unit(engine) * (integral_first - integral_last);
+      double const x = this->integral_inverse(u);
+      double const rounded = std::floor(x + 0.5);
+      long long k = rounded < 1 ? 1
+                    : rounded >= static_cast<double>(n)
+                        ? n
+                        : static_cast<long long>(rounded);
+      double const kx = static_cast<double>(k);
+      if (kx - x <= squeeze || u >= this->integral(kx + 0.5) - this->h(kx))
+        return k;
+    }
+  }
+  /**
+   * @brief The number of ranks.
+   *
+   */
+  long long count() const { return n; }
+  /**
+   * @brief The exponent.
+   *
+   */
+  double exponent() const { return s; }
+  /**
+   * @brief The distribution keeps no state between draws.
+   *
+   */
+  void reset() {}
+};
+}  // namespace distributions
+}  // namespace maker
+}  // namespace testcaser
+#endif
@@ -0,0 +1,708 @@
+/**
+ *   Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef ENGINES_HPP
+#define ENGINES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <testcaser/core/maker/randoms/seeding.hpp>
+
+namespace testcaser {
+namespace maker {
+/**
+ * @brief The namespace that holds the random number engines shipped with the
+ * maker. They can be used as the Generator of all the random types.
+ *
+ */
+namespace engines {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+/**
+ * @brief Defined when the bulk generation of the engines can be compiled a
+ * second time for AVX2 and picked at runtime on the processors having it.
+ *
+ */
+#define _TESTCASER_AVX2_DISPATCH
+#endif
+/**
+ * @brief The 128 bit arithmetic the engines need. The native type of the
+ * compiler is used when there is one.
+ *
+ */
+namespace wide {
+#ifdef __SIZEOF_INT128__
+typedef unsigned __int128 uint128;
+inline uint128 make(std::uint64_t high, std::uint64_t low) {
+  return (static_cast<uint128>(high) << 64) | low;
+}
+inline std::uint64_t high(uint128 value) {
+  return static_cast<std::uint64_t>(value >> 64);
+}
+inline std::uint64_t low(uint128 value) {
+  return static_cast<std::uint64_t>(value);
+}
+inline uint128 multiply(std::uint64_t a, std::uint64_t b) {
+  return static_cast<uint128>(a) * b;
+}
+#else
+struct uint128 {
+  std::uint64_t hi, lo;
+};
+inline uint128 make(std::uint64_t high, std::uint64_t low) {
+  return uint128{high, low};
+}
+inline std::uint64_t high(uint128 value) { return value.hi; }
+inline std::uint64_t low(uint128 value) { return value.lo; }
+inline uint128 multiply(std::uint64_t a, std::uint64_t b) {
+  std::uint64_t const a_lo = a & 0xFFFFFFFFu, a_hi = a >> 32;
+  std::uint64_t const b_lo = b & 0xFFFFFFFFu, b_hi = b >> 32;
+  std::uint64_t const ll = a_lo * b_lo, lh = a_lo * b_hi, hl = a_hi * b_lo;
+  std::uint64_t const middle = (ll >> 32) + (lh & 0xFFFFFFFFu) + hl;
+  return uint128{a_hi * b_hi + (lh >> 32) + (middle >> 32),
+                 (middle << 32) | (ll & 0xFFFFFFFFu)};
+}
+inline uint128 operator+(uint128 a, uint128 b) {
+  std::uint64_t const lo = a.lo + b.lo;
+  return uint128{a.hi + b.hi + (lo < a.lo ? 1 : 0), lo};
+}
+inline uint128 operator*(uint128 a, uint128 b) {
+  uint128 product = multiply(a.lo, b.lo);
+  product.hi += a.hi * b.lo + a.lo * b.hi;
+  return product;
+}
+inline bool operator==(uint128 a, uint128 b) {
+  return a.hi == b.hi && a.lo == b.lo;
+}
+#endif
+}  // namespace wide
+
+/**
+ * @brief The Philox4x32-10 counter based engine of Salmon et al. The value at
+ * any position is computed from (seed, stream, offset) alone, so the engine
+ * can jump to any position in constant time. Give every independent part of a
+ * test its own stream, or seek(..) to the position of a value, to regenerate
+ * that part without generating what comes before it.
+ *
+ */
+class Philox4x32 {
+  std::uint32_t key[2];
+  unsigned long long stream_id = 0, position = 0;
+  // the block of four values at the counter cached_block
+  std::uint32_t block[4];
+  unsigned long long cached_block = 0;
+  bool cached = false;
+
+  static void mulhilo(std::uint32_t a, std::uint32_t b, std::uint32_t& hi,
+                      std::uint32_t& lo) {
+    std::uint64_t const product =
+        static_cast<std::uint64_t>(a) * static_cast<std::uint64_t>(b);
+    hi = static_cast<std::uint32_t>(product >> 32);
+    lo = static_cast<std::uint32_t>(product);
+  }
+  void generate(unsigned long long counter) {
+    std::uint32_t c[4] = {static_cast<std::uint32_t>(counter),
+                          static_cast<std::uint32_t>(counter >> 32),
+                          static_cast<std::uint32_t>(stream_id),
+                          static_cast<std::uint32_t>(stream_id >> 32)};
+    std::uint32_t k0 = key[0], k1 = key[1];
+    for (int round = 0; round < 10; round++) {
+      std::uint32_t hi0, lo0, hi1, lo1;
+      mulhilo(0xD2511F53u, c[0], hi0, lo0);
+      mulhilo(0xCD9E8D57u, c[2], hi1, lo1);
+      c[0] = hi1 ^ c[1] ^ k0;
+      c[1] = lo1;
+      c[2] = hi0 ^ c[3] ^ k1;
+      c[3] = lo0;
+      k0 += 0x9E3779B9u;
+      k1 += 0xBB67AE85u;
+    }
+    for (int t = 0; t < 4; t++) block[t] = c[t];
+    cached_block = counter;
+    cached = true;
+  }
+
+ public:
+  /**
+   * @brief The type of the values generated.
+   *
+   */
+  typedef std::uint32_t result_type;
+  /**
+   * @brief The smallest value generated.
+   *
+   */
+  static constexpr result_type min() { return 0; }
+  /**
+   * @brief The largest value generated.
+   *
+   */
+  static constexpr result_type max() { return 0xFFFFFFFFu; }
+  /**
+   * @brief Construct a new Philox4x32 object at the start of stream 0 of the
+   * default seed.
+   *
+   */
+  Philox4x32() { this->seed(0); }
+  /**
+   * @brief Construct a new Philox4x32 object
+   *
+   * @param seed_value the seed, all of its 64 bits are used
+   * @param stream the stream of the seed to generate
+   * @param offset the position in the stream of the first value
+   */
+  explicit Philox4x32(unsigned long long seed_value,
+                      unsigned long long stream = 0,
+                      unsigned long long offset = 0) {
+    this->seed(seed_value, stream, offset);
+  }
+  /**
+   * @brief Seeds the engine and moves it to a position.
+   *
+   * @param seed_value the seed, all of its 64 bits are used
+   * @param stream the stream of the seed to generate
+   * @param offset the position in the stream of the next value
+   */
+  void seed(unsigned long long seed_value, unsigned long long stream = 0,
+            unsigned long long offset = 0) {
+    key[0] = static_cast<std::uint32_t>(seed_value);
+    key[1] = static_cast<std::uint32_t>(seed_value >> 32);
+    cached = false;
+    this->seek(stream, offset);
+  }
+  /**
+   * @brief Moves the engine to a position of the current seed in constant
+   * time.
+   *
+   * @param stream the stream to generate
+   * @param offset the position in the stream of the next value
+   */
+  void seek(unsigned long long stream, unsigned long long offset) {
+    if (stream != stream_id) cached = false;
+    stream_id = stream;
+    position = offset;
+  }
+  /**
+   * @brief Skips count values in constant time.
+   *
+   * @param count the number of values to skip
+   */
+  void discard(unsigned long long count) { position += count; }
+  /**
+   * @brief The stream being generated.
+   *
+   * @return unsigned long long the stream
+   */
+  unsigned long long stream() const { return stream_id; }
+  /**
+   * @brief The position in the stream of the next value.
+   *
+   * @return unsigned long long the offset
+   */
+  unsigned long long offset() const { return position; }
+  /**
+   * @brief Generates the next value.
+   *
+   * @return result_type the value
+   */
+  result_type operator()() {
+    unsigned long long const counter = position >> 2;
+    if (!cached || counter != cached_block) this->generate(counter);
+    return block[position++ & 3];
+  }
+  /**
+   * @brief Two engines are equal when they generate the same values.
+   *
+   */
+  bool operator==(Philox4x32 const& other) const {
+    return key[0] == other.key[0] && key[1] == other.key[1] &&
+           stream_id == other.stream_id && position == other.position;
+  }
+  /**
+   * @brief Two engines are unequal when they generate different values.
+   *
+   */
+  bool operator!=(Philox4x32 const& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief The xoshiro256** engine of Blackman and Vigna. It keeps 32 bytes of
+ * state and generates 64 bit values. jump() moves it 2^128 values ahead which
+ * splits it into non-overlapping sequences.
+ *
+ */
+class Xoshiro256 {
+  std::uint64_t s[4];
+  friend class Xoshiro256x4;
+
+  static std::uint64_t rotl(std::uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+  }
+
+ public:
+  /**
+   * @brief The type of the values generated.
+   *
+   */
+  typedef std::uint64_t result_type;
+  /**
+   * @brief The smallest value generated.
+   *
+   */
+  static constexpr result_type min() { return 0; }
+  /**
+   * @brief The largest value generated.
+   *
+   */
+  static constexpr result_type max() { return ~static_cast<result_type>(0); }
+  /**
+   * @brief Construct a new Xoshiro256 object with the default seed.
+   *
+   */
+  Xoshiro256() { this->seed(0); }
+  /**
+   * @brief Construct a new Xoshiro256 object
+   *
+   * @param seed_value the seed
+   */
+  explicit Xoshiro256(unsigned long long seed_value) { this->seed(seed_value); }
+  /**
+   * @brief Seeds the engine. The state is expanded from the seed with
+   * SplitMix64 as recommended by the authors.
+   *
+   * @param seed_value the seed
+   */
+  void seed(unsigned long long seed_value) {
+    for (int t = 0; t < 4; t++) s[t] = seeding::derive(seed_value, t);
+  }
+  /**
+   * @brief Generates the next value.
+   *
+   * @return result_type the value
+   */
+  result_type operator()() {
+    std::uint64_t const result = rotl(s[1] * 5, 7) * 9;
+    std::uint64_t const shifted = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= shifted;
+    s[3] = rotl(s[3], 45);
+    return result;
+  }
+  /**
+   * @brief Skips count values.
+   *
+   * @param count the number of values to skip
+   */
+  void discard(unsigned long long count) {
+    while (count-- > 0) (*this)();
+  }
+  /**
+   * @brief Moves the engine 2^128 values ahead.
+   *
+   */
+  void jump() {
+    static std::uint64_t const polynomial[4] = {
+        0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull,
+        0x39ABDC4529B1661Cull};
+    std::uint64_t jumped[4] = {0, 0, 0, 0};
+    for (int w = 0; w < 4; w++) {
+      for (int b = 0; b < 64; b++) {
+        if (polynomial[w] & (1ull << b))
+          for (int t = 0; t < 4; t++) jumped[t] ^= s[t];
+        (*this)();
+      }
+    }
+    for (int t = 0; t < 4; t++) s[t] = jumped[t];
+  }
+  /**
+   * @brief Two engines are equal when they generate the same values.
+   *
+   */
+  bool operator==(Xoshiro256 const& other) const {
+    return s[0] == other.s[0] && s[1] == other.s[1] && s[2] == other.s[2] &&
+           s[3] == other.s[3];
+  }
+  /**
+   * @brief Two engines are unequal when they generate different values.
+   *
+   */
+  bool operator!=(Xoshiro256 const& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief The bulk generation of the multi lane engines. The lanes are stored
+ * word by word so that the loops over them are vectorized by the compiler.
+ *
+ */
+namespace lanes {
+/**
+ * @brief Advances the four lanes of xoshiro256** blocks times and writes the
+ * four values of every step to out.
+ *
+ * @param s the state, s[w][l] being the w-th word of the l-th lane
+ * @param out the values, 4 * blocks of them
+ * @param blocks the number of steps
+ */
+#ifdef _TESTCASER_AVX2_DISPATCH
+__attribute__((always_inline))
+#endif
+inline void xoshiro_blocks(std::uint64_t (&s)[4][4], std::uint64_t* out,
+                           std::size_t blocks) {
+  for (std::size_t b = 0; b < blocks; b++, out += 4) {
+    for (int l = 0; l < 4; l++) {
+      // rotl(s1 * 5, 7) * 9 with the multiplications as shifts, which
+      // vectorize without 64 bit multiplications
+      std::uint64_t const times5 = (s[1][l] << 2) + s[1][l];
+      std::uint64_t const rotated = (times5 << 7) | (times5 >> 57);
+      out[l] = (rotated << 3) + rotated;
+      std::uint64_t const shifted = s[1][l] << 17;
+      s[2][l] ^= s[0][l];
+      s[3][l] ^= s[1][l];
+      s[1][l] ^= s[2][l];
+      s[0][l] ^= s[3][l];
+      s[2][l] ^= shifted;
+      s[3][l] = (s[3][l] << 45) | (s[3][l] >> 19);
+    }
+  }
+}
+#ifdef _TESTCASER_AVX2_DISPATCH
+/**
+ * @brief xoshiro_blocks(..) compiled for AVX2.
+ *
+ */
+__attribute__((target("avx2"))) inline void xoshiro_blocks_avx2(
+    std::uint64_t (&s)[4][4], std::uint64_t* out, std::size_t blocks) {
+  xoshiro_blocks(s, out, blocks);
+}
+#endif
+/**
+ * @brief Does the processor running the program support AVX2.
+ *
+ */
+inline bool has_avx2() {
+#ifdef _TESTCASER_AVX2_DISPATCH
+  static bool const supported = __builtin_cpu_supports("avx2");
+  return supported;
+#else
+  return false;
+#endif
+}
+}  // namespace lanes
+
+/**
+ * @brief Four xoshiro256** engines stepped together. The first lane is
+ * Xoshiro256 seeded with the same seed and every other lane is the previous
+ * one jumped 2^128 values ahead, so the lanes never overlap. The values are
+ * the four lanes in turn. fill(..) generates them in bulk with the AVX2
+ * version of the loop when the processor has it and the portable one
+ * otherwise; both give the same values.
+ *
+ */
+class Xoshiro256x4 {
+  std::uint64_t s[4][4];
+  // the values of the last step not handed out yet
+  std::uint64_t block[4];
+  int next = 4;
+
+  void blocks(std::uint64_t* out, std::size_t count) {
+#ifdef _TESTCASER_AVX2_DISPATCH
+    if (lanes::has_avx2()) return lanes::xoshiro_blocks_avx2(s, out, count);
+#endif
+    lanes::xoshiro_blocks(s, out, count);
+  }
+
+ public:
+  /**
+   * @brief The type of the values generated.
+   *
+   */
+  typedef std::uint64_t result_type;
+  /**
+   * @brief The smallest value generated.
+   *
+   */
+  static constexpr result_type min() { return 0; }
+  /**
+   * @brief The largest value generated.
+   *
+   */
+  static constexpr result_type max() { return ~static_cast<result_type>(0); }
+  /**
+   * @brief Construct a new Xoshiro256x4 object with the default seed.
+   *
+   */
+  Xoshiro256x4() { this->seed(0); }
+  /**
+   * @brief Construct a new Xoshiro256x4 object
+   *
+   * @param seed_value the seed
+   */
+  explicit Xoshiro256x4(unsigned long long seed_value) {
+    this->seed(seed_value);
+  }
+  /**
+   * @brief Seeds the engine. The lanes are jumped apart from the seeded
+   * Xoshiro256, which takes a few thousand steps.
+   *
+   * @param seed_value the seed
+   */
+  void seed(unsigned long long seed_value) {
+    Xoshiro256 lane(seed_value);
+    for (int l = 0; l < 4; l++) {
+      for (int w = 0; w < 4; w++) s[w][l] = lane.s[w];
+      lane.jump();
+    }
+    next = 4;
+  }
+  /**
+   * @brief Generates the next value.
+   *
+   * @return result_type the value
+   */
+  result_type operator()() {
+    if (next == 4) {
+      this->blocks(block, 1);
+      next = 0;
+    }
+    return block[next++];
+  }
+  /**
+   * @brief Generates count values at once. They are the values count calls
+   * of operator() would return.
+   *
+   * @param out the values
+   * @param count the number of values
+   */
+  void fill(std::uint64_t* out, std::size_t count) {
+    while (next < 4 && count > 0) {
+      *out++ = block[next++];
+      count--;
+    }
+    this->blocks(out, count / 4);
+    out += count / 4 * 4;
+    for (std::size_t t = 0; t < count % 4; t++) *out++ = (*this)();
+  }
+  /**
+   * @brief Skips count values.
+   *
+   * @param count the number of values to skip
+   */
+  void discard(unsigned long long count) {
+    while (count-- > 0) (*this)();
+  }
+  /**
+   * @brief Two engines are equal when they generate the same values.
+   *
+   */
+  bool operator==(Xoshiro256x4 const& other) const {
+    for (int w = 0; w < 4; w++)
+      for (int l = 0; l < 4; l++)
+        if (s[w][l] != other.s[w][l]) return false;
+    if (next != other.next) return false;
+    for (int t = next; t < 4; t++)
+      if (block[t] != other.block[t]) return false;
+    return true;
+  }
+  /**
+   * @brief Two engines are unequal when they generate different values.
+   *
+   */
+  bool operator!=(Xoshiro256x4 const& other) const {
+    return !(*this == other);
+  }
+};
+
+/**
+ * @brief The pcg64 engine (PCG XSL RR 128/64) of O'Neill. It keeps a 128 bit
+ * state, generates 64 bit values, has 2^127 selectable streams and skips any
+ * number of values in logarithmic time.
+ *
+ */
+class PCG64 {
+  wide::uint128 state, increment;
+
+  static wide::uint128 multiplier() {
+    return wide::make(0x2360ED051FC65DA4ull, 0x4385DF649FCCF645ull);
+  }
+  void step() { state = state * multiplier() + increment; }
+
+ public:
+  /**
+   * @brief The type of the values generated.
+   *
+   */
+  typedef std::uint64_t result_type;
+  /**
+   * @brief The smallest value generated.
+   *
+   */
+  static constexpr result_type min() { return 0; }
+  /**
+   * @brief The largest value generated.
+   *
+   */
+  static constexpr result_type max() { return ~static_cast<result_type>(0); }
+  /**
+   * @brief Construct a new PCG64 object with the default seed.
+   *
+   */
+  PCG64() { this->seed(0); }
+  /**
+   * @brief Construct a new PCG64 object
+   *
+   * @param seed_value the seed
+   * @param stream the stream, 0 selects the default stream of pcg64
+   */
+  explicit PCG64(unsigned long long seed_value, unsigned long long stream = 0) {
+    this->seed(seed_value, stream);
+  }
+  /**
+   * @brief Seeds the engine the way pcg64 does.
+   *
+   * @param seed_value the seed
+   * @param stream the stream, 0 selects the default stream of pcg64
+   */
+  void seed(unsigned long long seed_value, unsigned long long stream = 0) {
+    increment = stream == 0
+                    ? wide::make(0x5851F42D4C957F2Dull, 0x14057B7EF767814Full)
+                    : wide::make(stream >> 63, (stream << 1) | 1u);
+    state = wide::make(0, 0);
+    this->step();
+    state = state + wide::make(0, seed_value);
+    this->step();
+  }
+  /**
+   * @brief Generates the next value.
+   *
+   * @return result_type the value
+   */
+  result_type operator()() {
+    this->step();
+    std::uint64_t const folded = wide::high(state) ^ wide::low(state);
+    unsigned const rotation = static_cast<unsigned>(wide::high(state) >> 58);
+    return (folded >> rotation) | (folded << ((64 - rotation) & 63));
+  }
+  /**
+   * @brief Skips count values in logarithmic time.
+   *
+   * @param count the number of values to skip
+   */
+  void discard(unsigned long long count) {
+    wide::uint128 factor = multiplier(), addend = increment;
+    wide::uint128 total_factor = wide::make(0, 1), total_addend = wide::make(0, 0);
+    while (count > 0) {
+      if (count & 1) {
+        total_factor = total_factor * factor;
+        total_addend = total_addend * factor + addend;
+      }
+      addend = (factor + wide::make(0, 1)) * addend;
+      factor = factor * factor;
+      count >>= 1;
+    }
+    state = total_factor * state + total_addend;
+  }
+  /**
+   * @brief Two engines are equal when they generate the same values.
+   *
+   */
+  bool operator==(PCG64 const& other) const {
+    return state == other.state && increment == other.increment;
+  }
+  /**
+   * @brief Two engines are unequal when they generate different values.
+   *
+   */
+  bool operator!=(PCG64 const& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief The wyrand engine of Wang Yi. It keeps 8 bytes of state, generates
+ * 64 bit values with a single multiplication and skips values in constant
+ * time. It is the cheapest engine to construct and to copy.
+ *
+ */
+class WyRand {
+  std::uint64_t state;
+
+ public:
+  /**
+   * @brief The type of the values generated.
+   *
+   */
+  typedef std::uint64_t result_type;
+  /**
+   * @brief The smallest value generated.
+   *
+   */
+  static constexpr result_type min() { return 0; }
+  /**
+   * @brief The largest value generated.
+   *
+   */
+  static constexpr result_type max() { return ~static_cast<result_type>(0); }
+  /**
+   * @brief Construct a new WyRand object with the default seed.
+   *
+   */
+  WyRand() : state(0) {}
+  /**
+   * @brief Construct a new WyRand object
+   *
+   * @param seed_value the seed
+   */
+  explicit WyRand(unsigned long long seed_value) : state(seed_value) {}
+  /**
+   * @brief Seeds the engine.
+   *
+   * @param seed_value the seed
+   */
+  void seed(unsigned long long seed_value) { state = seed_value; }
+  /**
+   * @brief Generates the next value.
+   *
+   * @return result_type the value
+   */
+  result_type operator()() {
+    state += 0xA0761D6478BD642Full;
+    wide::uint128 const product =
+        wide::multiply(state, state ^ 0xE7037ED1A0B428DBull);
+    return wide::high(product) ^ wide::low(product);
+  }
+  /**
+   * @brief Skips count values in constant time.
+   *
+   * @param count the number of values to skip
+   */
+  void discard(unsigned long long count) {
+    state += 0xA0761D6478BD642Full * count;
+  }
+  /**
+   * @brief Two engines are equal when they generate the same values.
+   *
+   */
+  bool operator==(WyRand const& other) const { return state == other.state; }
+  /**
+   * @brief Two engines are unequal when they generate different values.
+   *
+   */
+  bool operator!=(WyRand const& other) const { return !(*this == other); }
+};
+}  // namespace engines
+}  // namespace maker
+}  // namespace testcaser
+#endif
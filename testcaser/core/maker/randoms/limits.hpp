@@ -87,8 +87,255 @@ struct Intervals {
     return this->lower > that.lower;
   }
 };
+
+/**
+ * @brief Moves a value forward by some steps without overflowing signed types.
+ *
+ * @tparam T the type of the value
+ * @param base the value to move
+ * @param steps the number of steps
+ * @return T the moved value
+ */
+template <class T>
+T advance(T base, unsigned long long steps) {
+  return static_cast<T>(static_cast<unsigned long long>(base) + steps);
+}
+
+/**
+ * @brief The values allowed by a limit as a sorted list of disjoint intervals.
+ * The allowed values are numbered from 0 to size() - 1 in increasing order, so
+ * a value can be sampled with a single draw of its number and mapped back with
+ * a binary search over the prefix sizes of the intervals.
+ *
+ * @tparam T the type of the limit
+ */
+template <class T>
+class AllowedRanges {
+  std::vector<Intervals<T>> ranges;
+  // prefix[i] is the number of allowed values before ranges[i]
+  std::vector<unsigned long long> prefix;
+  unsigned long long total = 0;
+
+  static unsigned long long distance(T from, T to) {
+    return static_cast<unsigned long long>(to) -
+           static_cast<unsigned long long>(from);
+  }
+
+ public:
+  /**
+   * @brief Construct a new Allowed Ranges object
+   *
+   * @param lower the lower limit (included)
+   * @param upper the upper limit (not included)
+   * @param excluded the intervals to exclude from [lower, upper)
+   */
+  AllowedRanges(T lower, T upper, std::vector<Intervals<T>> excluded) {
+    if (!std::is_sorted(excluded.begin(), excluded.end()))
+      std::sort(excluded.begin(), excluded.end());
+    T start = lower;
+    for (auto const& e : excluded) {
+      if (e.lower >= e.upper) continue;
+      if (e.lower > start) {
+        ranges.push_back(Intervals<T>(start, e.lower));
+        prefix.push_back(total);
+        total += distance(start, e.lower);
+      }
+      if (e.upper > start) start = e.upper;
+    }
+    if (upper > start) {
+      ranges.push_back(Intervals<T>(start, upper));
+      prefix.push_back(total);
+      total += distance(start, upper);
+    }
+    if (total == 0)
+      throw testcaser::exceptions::maker::LimitExhaustedError(
+          "All the values of the limit are excluded by its interval "
+          "exceptions");
+  }
+  /**
+   * @brief The number of allowed values.
+   *
+   * @return unsigned long long the number of values
+   */
+  unsigned long long size() const { return total; }
+  /**
+   * @brief The allowed intervals, sorted and disjoint.
+   *
+   * @return std::vector<Intervals<T>> const& the intervals
+   */
+  std::vector<Intervals<T>> const& intervals() const { return ranges; }
+  /**
+   * @brief The allowed value with the given number.
+   *
+   * @param index the number of the value, less than size()
+   * @return T the value
+   */
+  T at(unsigned long long index) const {
+    if (ranges.size() == 1) return advance(ranges[0].lower, index);
+    std::size_t const t =
+        std::upper_bound(prefix.begin(), prefix.end(), index) -
+        prefix.begin() - 1;
+    return advance(ranges[t].lower, index - prefix[t]);
+  }
+  /**
+   * @brief The number of allowed values strictly less than the value.
+   *
+   * @param value the value
+   * @return unsigned long long the number of values
+   */
+  unsigned long long rank(T value) const {
+    auto const after = std::upper_bound(ranges.begin(), ranges.end(),
+                                        Intervals<T>(value, value));
+    if (after == ranges.begin()) return 0;
+    std::size_t const t = after - ranges.begin() - 1;
+    T const end = value < ranges[t].upper ? value : ranges[t].upper;
+    return prefix[t] + distance(ranges[t].lower, end);
+  }
+};
+/**
+ * @brief The helpers of StaticLimit. They are constexpr recursions as C++11
+ * allows no loops in constexpr functions.
+ *
+ */
+namespace statics {
+template <class T>
+constexpr T skip(T, T value) {
+  return value;
+}
+/**
+ * @brief Moves value past the excluded points, which must be sorted. The
+ * points below lower are not allowed values and are ignored, as by
+ * count_inside.
+ *
+ */
+template <class T, class... Rest>
+constexpr T skip(T lower, T value, T first, Rest... rest) {
+  return skip<T>(lower, first >= lower && first <= value ? value + 1 : value,
+                 rest...);
+}
+template <class T>
+constexpr unsigned long long count_inside(T, T) {
+  return 0;
+}
+/**
+ * @brief Counts the excluded points inside [lower, upper).
+ *
+ */
+template <class T, class... Rest>
+constexpr unsigned long long count_inside(T lower, T upper, T first,
+                                          Rest... rest) {
+  return (first >= lower && first < upper ? 1 : 0) +
+         count_inside<T>(lower, upper, rest...);
+}
+template <class T>
+constexpr bool increasing(T) {
+  return true;
+}
+/**
+ * @brief Checks that the points are strictly increasing.
+ *
+ */
+template <class T, class... Rest>
+constexpr bool increasing(T first, T second, Rest... rest) {
+  return first < second && increasing<T>(second, rest...);
+}
+template <class T>
+constexpr bool increasing() {
+  return true;
+}
+}  // namespace statics
 }  // namespace limits
 
+/**
+ * @brief A limit known at compile time. It allows the values of [Lower, Upper)
+ * except the Excluded points, which must be given in increasing order. Random
+ * types using it need no runtime limit and no rejection of excluded values:
+ * the allowed values are numbered and a number is mapped to its value with
+ * a few compile time comparisons.
+ *
+ * @tparam T the type of the limit
+ * @tparam Lower the lower limit (included)
+ * @tparam Upper the upper limit (not included)
+ * @tparam Excluded the points to exclude in increasing order
+ */
+template <class T, T Lower, T Upper, T... Excluded>
+struct StaticLimit {
+  static_assert(Lower < Upper,
+                "Lower limit must be strictly smaller than upper limit");
+  static_assert(limits::statics::increasing<T>(Excluded...),
+                "The excluded points must be in increasing order");
+  /**
+   * @brief The type of the limit.
+   *
+   */
+  typedef T value_type;
+  /**
+   * @brief The smallest allowed value.
+   *
+   */
+  static constexpr T LowerLimit = Lower;
+  /**
+   * @brief The upper limit (not included).
+   *
+   */
+  static constexpr T UpperLimit = Upper;
+  /**
+   * @brief The number of allowed values.
+   *
+   * @return unsigned long long the number of values
+   */
+  static constexpr unsigned long long size() {
+    return static_cast<unsigned long long>(Upper - Lower) -
+           limits::statics::count_inside<T>(Lower, Upper, Excluded...);
+  }
+  /**
+   * @brief The allowed value with the given number.
+   *
+   * @param index the number of the value, less than size()
+   * @return T the value
+   */
+  static constexpr T at(unsigned long long index) {
+    return limits::statics::skip<T>(Lower, static_cast<T>(Lower + index),
+                                    Excluded...);
+  }
+};
+template <class T, T Lower, T Upper, T... Excluded>
+constexpr T StaticLimit<T, Lower, Upper, Excluded...>::LowerLimit;
+template <class T, T Lower, T Upper, T... Excluded>
+constexpr T StaticLimit<T, Lower, Upper, Excluded...>::UpperLimit;
+
+namespace limits {
+/**
+ * @brief The static limit of the lower case alphabets.
+ *
+ */
+typedef StaticLimit<int, 'a', 'z' + 1> StaticLowerCaseAlphabet;
+/**
+ * @brief The static limit of the upper case alphabets.
+ *
+ */
+typedef StaticLimit<int, 'A', 'Z' + 1> StaticUpperCaseAlphabet;
+/**
+ * @brief The static limit of the upper and lower case alphabets.
+ *
+ */
+typedef StaticLimit<int, 'A', 'z' + 1, '[', '\\', ']', '^', '_', '`'>
+    StaticAlphabet;
+/**
+ * @brief The static limit of the digits of the radix, starting at 0.
+ *
+ */
+template <unsigned long long Radix>
+struct StaticDigits {
+  /**
+   * @brief type the limit [0, Radix)
+   *
+   */
+  typedef StaticLimit<unsigned long long, 0, Radix> type;
+};
+}  // namespace limits
+
+
 /**
  * @brief This is the base class that lays out the structure of all the limits.
  * All the limits must ineherit from this class
@@ -99,10 +346,69 @@ template <class T>
 class BaseLimitProperties {
  protected:
   /**
-   * @brief intervals in a vector to exclude the sampling from.
+   * @brief intervals to exclude the sampling from. They are kept sorted,
+   * disjoint and merged with the intervals they touch.
    *
    */
   std::vector<limits::Intervals<T>> except_intervals;
+  /**
+   * @brief excluded_size the number of values covered by except_intervals
+   *
+   */
+  unsigned long long excluded_size = 0;
+
+  /**
+   * @brief Inserts the interval [lower, upper) merging it with the intervals
+   * it overlaps or touches.
+   *
+   * @param lower the lower limit of the interval (included)
+   * @param upper the upper limit of the interval (not included)
+   */
+  void insert_exception(T lower, T upper) {
+    if (lower >= upper) return;
+    // the first interval ending at or after lower is the first one to merge
+    auto first = std::lower_bound(
+        except_intervals.begin(), except_intervals.end(), lower,
+        [](limits::Intervals<T> const& e, T value) { return e.upper < value; });
+    auto last = first;
+    for (; last != except_intervals.end() && last->lower <= upper; ++last) {
+      if (last->lower < lower) lower = last->lower;
+      if (last->upper > upper) upper = last->upper;
+      excluded_size -= measure(last->lower, last->upper);
+    }
+    first = except_intervals.erase(first, last);
+    except_intervals.insert(first, limits::Intervals<T>(lower, upper));
+    excluded_size += measure(lower, upper);
+  }
+  /**
+   * @brief Throws if [lower, upper) is not inside the limit.
+   *
+   */
+  void check_inside(T lower, T upper) const {
+    if (upper > UpperLimit || lower < LowerLimit) {
+      throw testcaser::exceptions::maker::LimitIntervalError(
+          "Intervals upper limit is : " + std::to_string(upper) +
+          " while Limit's upper limit is " + std::to_string(UpperLimit) +
+          " and for lower " + std::to_string(lower) + " and " +
+          std::to_string(LowerLimit) + " respectively.");
+    }
+  }
+  /**
+   * @brief Throws if the point is not inside the limit.
+   *
+   */
+  void check_point(T point) const {
+    if (point >= UpperLimit || point < LowerLimit) {
+      throw testcaser::exceptions::maker::LimitIntervalError(
+          "Point " + std::to_string(point) + " is outside the limit [" +
+          std::to_string(LowerLimit) + ", " + std::to_string(UpperLimit) +
+          ")");
+    }
+  }
+  static unsigned long long measure(T lower, T upper) {
+    return static_cast<unsigned long long>(upper) -
+           static_cast<unsigned long long>(lower);
+  }
 
  public:
   /**
@@ -136,20 +442,60 @@ class BaseLimitProperties {
   void add_interval_exception(std::pair<T, T> interval) {
     T upper =
         interval.first > interval.second ? interval.first : interval.second;
-    T lower = interval.first + interval.second - upper;
-    if (upper > UpperLimit || lower < LowerLimit) {
-      throw testcaser::exceptions::maker::LimitIntervalError(
-          "Intervals upper limit is : " + std::to_string(upper) +
-          " while Limit's upper limit is " + std::to_string(UpperLimit) +
-          " and for lower " + std::to_string(lower) + " and " +
-          std::to_string(LowerLimit) + " respectively.");
+    T lower =
+        interval.first > interval.second ? interval.second : interval.first;
+    this->check_inside(lower, upper);
+    this->insert_exception(lower, upper);
+  }
+  /**
+   * @brief Excludes a single value from the limit.
+   *
+   * @param point the value to exclude
+   */
+  void add_point_exception(T point) {
+    this->check_point(point);
+    this->insert_exception(point, point + 1);
+  }
+  /**
+   * @brief Excludes many single values from the limit at once. The points are
+   * sorted, joined into intervals when consecutive and merged with the
+   * existing exceptions in a single pass, which is much faster than adding
+   * them one by one.
+   *
+   * @param points the values to exclude
+   */
+  void add_point_exceptions(std::vector<T> points) {
+    std::sort(points.begin(), points.end());
+    std::vector<limits::Intervals<T>> merged;
+    merged.reserve(except_intervals.size() + points.size());
+    auto existing = except_intervals.begin();
+    // appends [lower, upper) to merged, the intervals arrive sorted by lower
+    auto push = [&merged](T lower, T upper) {
+      if (!merged.empty() && merged.back().upper >= lower) {
+        if (merged.back().upper < upper) merged.back().upper = upper;
+      } else {
+        merged.push_back(limits::Intervals<T>(lower, upper));
+      }
+    };
+    for (T point : points) {
+      this->check_point(point);
+      for (; existing != except_intervals.end() && existing->lower <= point;
+           ++existing)
+        push(existing->lower, existing->upper);
+      push(point, point + 1);
     }
-    except_intervals.emplace_back(std::make_pair(lower, upper));
+    for (; existing != except_intervals.end(); ++existing)
+      push(existing->lower, existing->upper);
+    except_intervals.swap(merged);
+    excluded_size = 0;
+    for (auto const& e : except_intervals)
+      excluded_size += measure(e.lower, e.upper);
   }
 
   /**
    * @brief checks if a value produced T is a valid as per the limit constraints
-   * with exception internals in mind.
+   * with exception internals in mind. It is a binary search over the
+   * exceptions.
    *
    * @param out the value to check for
    * @return true if doesn't violates the limit rules
@@ -157,32 +503,58 @@ class BaseLimitProperties {
    */
   bool valid_output(T out) const {
     if (out >= UpperLimit || out < LowerLimit) return false;
-    for (auto& e : except_intervals)
-      if (out >= e.lower && out < e.upper) return false;
-    return true;
+    auto after = std::upper_bound(except_intervals.begin(),
+                                  except_intervals.end(),
+                                  limits::Intervals<T>(out, out));
+    return after == except_intervals.begin() || (after - 1)->upper <= out;
+  }
+  /**
+   * @brief Clamps a value to the nearest value allowed by the limit. Values
+   * outside the limit become its nearest end and values inside an exception
+   * the nearest value around it, the smaller one on a tie. It is a binary
+   * search over the exceptions.
+   *
+   * @param out the value to clamp
+   * @return T the allowed value nearest to out
+   */
+  T clamp(T out) const {
+    if (out < LowerLimit) out = LowerLimit;
+    if (out >= UpperLimit) out = UpperLimit - 1;
+    auto after = std::upper_bound(except_intervals.begin(),
+                                  except_intervals.end(),
+                                  limits::Intervals<T>(out, out));
+    if (after == except_intervals.begin() || (after - 1)->upper <= out)
+      return out;
+    // the exceptions are merged, so the values around one are allowed
+    limits::Intervals<T> const& excluded = *(after - 1);
+    bool const below = excluded.lower > LowerLimit;
+    bool const above = excluded.upper < UpperLimit;
+    if (!below && !above) {
+      throw testcaser::exceptions::maker::LimitExhaustedError(
+          "All the values of the limit are excluded by its interval "
+          "exceptions");
+    }
+    if (!above || (below && measure(excluded.lower - 1, out) <=
+                                measure(out, excluded.upper)))
+      return excluded.lower - 1;
+    return excluded.upper;
+  }
+  /**
+   * @brief The values allowed by this limit as sorted disjoint intervals.
+   *
+   * @return limits::AllowedRanges<T> the allowed values
+   */
+  limits::AllowedRanges<T> allowed_ranges() const {
+    return limits::AllowedRanges<T>(LowerLimit, UpperLimit, except_intervals);
   }
   /**
    * @brief The limit size after excluding all the exceptions in between them
    *
    * @return unsigned long long the value of the limit size
    */
-  unsigned long long actual_limit_size() {
-    T min, max;
-    unsigned long long total_size = UpperLimit - LowerLimit;
-    if (except_intervals.size() == 0) return total_size;
-    std::sort(except_intervals.begin(), except_intervals.end());
-    min = except_intervals[0].lower;
-    max = except_intervals[except_intervals.size() - 1].upper;
-    total_size -= max - min;
-    auto active = except_intervals[0];
-    for (int t = 1; t < except_intervals.size(); t++) {
-      if (except_intervals[t].lower >= active.upper)
-        total_size += except_intervals[t].lower - active.upper;
-      if (active.upper < except_intervals[t].upper)
-        active = except_intervals[t];
-    }
-    return total_size;
-  };
+  unsigned long long actual_limit_size() const {
+    return measure(LowerLimit, UpperLimit) - excluded_size;
+  }
 };
 
 /**
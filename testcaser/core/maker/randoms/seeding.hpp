@@ -0,0 +1,54 @@
+/**
+ *   Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef SEEDING_HPP
+#define SEEDING_HPP
+
+namespace testcaser {
+namespace maker {
+/**
+ * @brief The namespace that derives independent seeds from a single master
+ * seed, so that a complete generator can be reproduced from one number.
+ *
+ */
+namespace seeding {
+/**
+ * @brief The SplitMix64 finalizer. It maps close inputs to unrelated outputs.
+ *
+ * @param value the value to mix
+ * @return unsigned long long the mixed value
+ */
+inline unsigned long long mix(unsigned long long value) {
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+  return value ^ (value >> 31);
+}
+/**
+ * @brief Derives the seed of the index-th stream of the master seed. The same
+ * master and index always give the same seed.
+ *
+ * @param master the master seed
+ * @param index the index of the stream
+ * @return unsigned long long the seed of the stream
+ */
+inline unsigned long long derive(unsigned long long master,
+                                 unsigned long long index) {
+  return mix(master + 0x9E3779B97F4A7C15ull * (index + 1));
+}
+}  // namespace seeding
+}  // namespace maker
+}  // namespace testcaser
+#endif
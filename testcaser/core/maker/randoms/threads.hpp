@@ -0,0 +1,214 @@
+/**
+ *   Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+#ifndef THREADS_HPP
+#define THREADS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <string>
+#include <testcaser/core/exceptions/InvalidLimit.hpp>
+#include <testcaser/core/maker/randoms/seeding.hpp>
+
+namespace testcaser {
+namespace maker {
+/**
+ * @brief The namespace that lets random objects be shared between threads.
+ * The engine of a random object is not thread safe, get() is const but it
+ * advances the engine. Objects built on a LocalEngine draw from an engine of
+ * the calling thread instead, so a single object can be used by many threads
+ * at once.
+ *
+ */
+namespace threads {
+/**
+ * @brief The registry of the engines of the threads. Every thread has its own
+ * engine of type Generator, seeded with the seed its stream derives from the
+ * master seed. A thread may bind itself to a stream, usually its index, which
+ * makes its values independent of the scheduling. Threads that are not bound
+ * are given the next free stream on their first draw. The two kinds of
+ * streams never meet: the bound ones are below first_unbound() and the
+ * unbound ones are counted from it, so an unbound thread never draws the
+ * values of the thread bound to 0.
+ *
+ * @tparam Generator the random number generator of the threads
+ */
+template <class Generator = std::mt19937>
+class EngineRegistry {
+  // the engine of a thread and the generation of the master seed it was seeded
+  // for. It is reseeded lazily once the master seed changes.
+  struct Local {
+    unsigned long long generation = 0;
+    unsigned long long stream = 0;
+    bool bound = false;
+    Generator engine;
+  };
+
+  static std::atomic<unsigned long long>& master() {
+    static std::atomic<unsigned long long> value{std::random_device()()};
+    return value;
+  }
+  static std::atomic<unsigned long long>& generation() {
+    static std::atomic<unsigned long long> value(1);
+    return value;
+  }
+  static std::atomic<unsigned long long>& next_stream() {
+    static std::atomic<unsigned long long> value(0);
+    return value;
+  }
+  static Local& local() {
+    static thread_local Local state;
+    return state;
+  }
+  static void refresh(Local& state, unsigned long long current) {
+    if (!state.bound) state.stream = first_unbound() | next_stream()++;
+    state.engine.seed(static_cast<typename Generator::result_type>(
+        seeding::derive(master().load(), state.stream)));
+    state.generation = current;
+  }
+
+ public:
+  EngineRegistry() = delete;
+  /**
+   * @brief The first stream given to the unbound threads, the high bit. The
+   * streams threads bind to must be below it.
+   *
+   * @return unsigned long long the first unbound stream
+   */
+  static constexpr unsigned long long first_unbound() { return 1ULL << 63; }
+  /**
+   * @brief Sets the master seed of all the threads. Every thread is reseeded
+   * on its next draw and the unbound threads are given new streams in the
+   * order they draw. It should be called before the threads start drawing.
+   *
+   * @param master_seed the master seed
+   */
+  static void seed(unsigned long long master_seed) {
+    master() = master_seed;
+    next_stream() = 0;
+    generation()++;
+  }
+  /**
+   * @brief Binds the calling thread to a stream and reseeds its engine. The
+   * values of the thread then only depend on the master seed and the stream.
+   *
+   * @param stream the stream of the thread, usually its index, below
+   * first_unbound()
+   */
+  static void bind(unsigned long long stream) {
+    if (stream >= first_unbound()) {
+      throw testcaser::exceptions::maker::LimitError(
+          "Stream " + std::to_string(stream) +
+          " is kept for the unbound threads, bind to a stream below 2^63");
+    }
+    Local& state = local();
+    state.bound = true;
+    state.stream = stream;
+    refresh(state, generation().load());
+  }
+  /**
+   * @brief The stream of the calling thread.
+   *
+   * @return unsigned long long the stream
+   */
+  static unsigned long long stream() {
+    engine();
+    return local().stream;
+  }
+  /**
+   * @brief The engine of the calling thread. It must not be handed to another
+   * thread.
+   *
+   * @return Generator& the engine
+   */
+  static Generator& engine() {
+    Local& state = local();
+    unsigned long long const current =
+        generation().load(std::memory_order_acquire);
+    if (state.generation != current) refresh(state, current);
+    return state.engine;
+  }
+};
+
+/**
+ * @brief An engine that forwards every draw to the engine of the calling
+ * thread in the EngineRegistry. It holds no state, so a random object built
+ * on it, say RandomInteger<LocalEngine<>>, can be shared between threads.
+ *
+ * @tparam Generator the random number generator of the threads
+ */
+template <class Generator = std::mt19937>
+class LocalEngine {
+ public:
+  /**
+   * @brief The type of the values generated.
+   *
+   */
+  typedef typename Generator::result_type result_type;
+  /**
+   * @brief The smallest value generated.
+   *
+   */
+  static constexpr result_type min() { return Generator::min(); }
+  /**
+   * @brief The largest value generated.
+   *
+   */
+  static constexpr result_type max() { return Generator::max(); }
+  /**
+   * @brief Construct a new Local Engine object. The seed is ignored, the
+   * engines of the threads are seeded by the EngineRegistry.
+   *
+   */
+  explicit LocalEngine(result_type = result_type()) {}
+  /**
+   * @brief Reseeds the engine of the calling thread.
+   *
+   * @param seed_value the seed
+   */
+  void seed(result_type seed_value) {
+    EngineRegistry<Generator>::engine().seed(seed_value);
+  }
+  /**
+   * @brief Generates the next value of the calling thread.
+   *
+   * @return result_type the value
+   */
+  result_type operator()() const {
+    return EngineRegistry<Generator>::engine()();
+  }
+};
+
+/**
+ * @brief Random types create their engine with share_or_create(..) when they
+ * are given none. A LocalEngine needs no seed, so it is created without the
+ * std::random_device call. It is found by argument dependent lookup.
+ *
+ * @tparam Generator the random number generator of the threads
+ * @param engine the engine to share, may be empty
+ * @return std::shared_ptr<LocalEngine<Generator>> the engine to use
+ */
+template <class Generator>
+std::shared_ptr<LocalEngine<Generator>> share_or_create(
+    std::shared_ptr<LocalEngine<Generator>> engine) {
+  if (engine) return engine;
+  return std::make_shared<LocalEngine<Generator>>();
+}
+}  // namespace threads
+}  // namespace maker
+}  // namespace testcaser
+#endif
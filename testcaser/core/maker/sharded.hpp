@@ -0,0 +1,217 @@
+/**
+ *   Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef SHARDED_HPP
+#define SHARDED_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <testcaser/core/maker/builder.hpp>
+#include <testcaser/core/maker/randoms/seeding.hpp>
+#include <testcaser/core/maker/sinks.hpp>
+#include <thread>
+#include <vector>
+
+namespace testcaser {
+namespace maker {
+/**
+ * @brief One independent part of a test generated by the ShardedBuilder. The
+ * callback of the segment writes to builder() and must seed every random
+ * object it uses from seed(..) so that the output only depends on the master
+ * seed and the index of the segment.
+ *
+ */
+class Segment {
+  std::size_t position;
+  unsigned long long base_seed;
+  TestCaseBuilder& output;
+
+ public:
+  /**
+   * @brief Construct a new Segment object
+   *
+   * @param idx the index of the segment in the test
+   * @param seed the seed of the segment
+   * @param builder the builder the segment writes to
+   */
+  Segment(std::size_t idx, unsigned long long seed, TestCaseBuilder& builder)
+      : position(idx), base_seed(seed), output(builder) {}
+  /**
+   * @brief The index of the segment in the test.
+   *
+   * @return std::size_t the index
+   */
+  std::size_t index() const { return position; }
+  /**
+   * @brief The seed of the stream-th random object of this segment.
+   *
+   * @param stream the number of the random object in the segment
+   * @return unsigned long long the seed to reseed_engine(..) it with
+   */
+  unsigned long long seed(std::size_t stream = 0) const {
+    return seeding::derive(base_seed, stream);
+  }
+  /**
+   * @brief The builder to write this segment to.
+   *
+   * @return TestCaseBuilder& the builder of this segment
+   */
+  TestCaseBuilder& builder() { return output; }
+};
+
+/**
+ * @brief Builds a single test file from segments that are generated in
+ * parallel. Every segment is written to its own in-memory builder on a worker
+ * thread and the segments are stitched in order into the file. The file is
+ * byte-identical for a given master seed whatever the number of threads.
+ *
+ */
+class ShardedBuilder {
+  std::shared_ptr<sinks::BaseSink> sink;
+  unsigned long long master_seed;
+  std::vector<std::function<void(Segment&)>> segments;
+
+ public:
+  ShardedBuilder(ShardedBuilder const&) = delete;
+  ShardedBuilder& operator=(ShardedBuilder const&) = delete;
+  /**
+   * @brief Construct a new Sharded Builder object
+   *
+   * @param abs_name The Absolute name of the testfile to generate.
+   * @param seed the master seed all the segment seeds are derived from
+   */
+  ShardedBuilder(std::string const& abs_name, unsigned long long seed)
+      : ShardedBuilder(std::make_shared<sinks::FileSink>(abs_name), seed) {}
+  /**
+   * @brief Construct a new Sharded Builder object
+   *
+   * @param output the sink to write the test to
+   * @param seed the master seed all the segment seeds are derived from
+   */
+  ShardedBuilder(std::shared_ptr<sinks::BaseSink> output,
+                 unsigned long long seed)
+      : sink(output), master_seed(seed) {}
+  /**
+   * @brief Appends a segment to the test.
+   *
+   * @param generate the callback that writes the segment
+   * @return ShardedBuilder& this builder
+   */
+  ShardedBuilder& add_segment(std::function<void(Segment&)> generate) {
+    segments.push_back(generate);
+    return *this;
+  }
+  /**
+   * @brief Appends count segments generated by the same callback. The
+   * callback can tell them apart with Segment::index().
+   *
+   * @param count the number of segments
+   * @param generate the callback that writes a segment
+   * @return ShardedBuilder& this builder
+   */
+  ShardedBuilder& add_segments(std::size_t count,
+                               std::function<void(Segment&)> generate) {
+    for (std::size_t t = 0; t < count; t++) segments.push_back(generate);
+    return *this;
+  }
+  /**
+   * @brief Generates all the segments and writes the test. At most twice as
+   * many segments as threads are kept in memory at once. The first exception
+   * thrown by a segment stops the build, is rethrown here and the unfinished
+   * test is discarded.
+   *
+   * @param threads the number of worker threads, 0 for one per core
+   */
+  void build(unsigned threads = 0) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    std::size_t const window = 2 * static_cast<std::size_t>(threads);
+
+    std::vector<std::shared_ptr<sinks::MemorySink>> done(segments.size());
+    std::size_t next = 0, written = 0;
+    std::exception_ptr failure;
+    std::mutex lock;
+    std::condition_variable changed;
+
+    auto work = [&]() {
+      for (;;) {
+        std::size_t idx;
+        {
+          std::unique_lock<std::mutex> guard(lock);
+          changed.wait(guard, [&] {
+            return failure || next >= segments.size() ||
+                   next < written + window;
+          });
+          if (failure || next >= segments.size()) return;
+          idx = next++;
+        }
+        auto memory = std::make_shared<sinks::MemorySink>();
+        try {
+          TestCaseBuilder part(memory);
+          part.set_verbose(false);
+          Segment segment(idx, seeding::derive(master_seed, idx), part);
+          segments[idx](segment);
+          part.finalize();
+        } catch (...) {
+          std::lock_guard<std::mutex> guard(lock);
+          if (!failure) failure = std::current_exception();
+          changed.notify_all();
+          return;
+        }
+        std::lock_guard<std::mutex> guard(lock);
+        done[idx] = memory;
+        changed.notify_all();
+      }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; t++) workers.emplace_back(work);
+    try {
+      TestCaseBuilder output(sink);
+      while (written < segments.size()) {
+        std::shared_ptr<sinks::MemorySink> part;
+        {
+          std::unique_lock<std::mutex> guard(lock);
+          changed.wait(guard, [&] { return failure || done[written]; });
+          if (failure) std::rethrow_exception(failure);
+          part.swap(done[written]);
+        }
+        output.add_raw(part->contents());
+        std::lock_guard<std::mutex> guard(lock);
+        written++;
+        changed.notify_all();
+      }
+      output.finalize();
+    } catch (...) {
+      {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!failure) failure = std::current_exception();
+        changed.notify_all();
+      }
+      for (auto& worker : workers) worker.join();
+      throw;
+    }
+    for (auto& worker : workers) worker.join();
+  }
+};
+}  // namespace maker
+}  // namespace testcaser
+#endif
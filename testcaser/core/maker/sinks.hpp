@@ -0,0 +1,506 @@
+/**
+ *   Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef SINKS_HPP
+#define SINKS_HPP
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <testcaser/core/exceptions/BuildException.hpp>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+#else
+#include <io.h>
+#include <sys/stat.h>
+#endif
+
+namespace testcaser {
+namespace maker {
+/**
+ * @brief The namespace that holds the outputs a TestCaseBuilder can write to.
+ *
+ */
+namespace sinks {
+/**
+ * @brief The Base Abstract sink. All the outputs of the TestCaseBuilder are
+ * inherited from this class.
+ *
+ */
+class BaseSink {
+ public:
+  /**
+   * @brief Writes the bytes to the sink. Throws TestFileIOError on failure.
+   *
+   * @param data the bytes to write
+   * @param count the number of bytes
+   */
+  virtual void write(char const* data, std::size_t count) = 0;
+  /**
+   * @brief Called once by the builder when it is finalized.
+   *
+   */
+  virtual void close() {}
+  /**
+   * @brief Called by the builder when it is destroyed without being finalized.
+   * The sink should throw away what was written.
+   *
+   */
+  virtual void discard() {}
+  /**
+   * @brief The name of the sink shown in the messages of the builder.
+   *
+   * @return std::string the name
+   */
+  virtual std::string name() const = 0;
+  /**
+   * @brief The descriptor from which the written test can be read back. It is
+   * used by the VirtualJudge to feed the test to the program.
+   *
+   * @return int the descriptor or -1 if the sink cannot be read back.
+   */
+  virtual int descriptor() const { return -1; }
+  /**
+   * @brief Sinks backed by memory the builder can format into directly return
+   * that memory here. The builder writes at most capacity bytes into it and
+   * then calls commit(..) with the number of bytes it wrote.
+   *
+   * @param minimum the number of bytes needed atleast
+   * @param capacity set to the number of bytes available
+   * @return char* the memory to write to, or nullptr if the sink must be
+   * written with write(..)
+   */
+  virtual char* acquire(std::size_t /* minimum */, std::size_t& capacity) {
+    capacity = 0;
+    return nullptr;
+  }
+  /**
+   * @brief Marks bytes of the memory returned by acquire(..) as written.
+   *
+   * @param count the number of bytes written
+   */
+  virtual void commit(std::size_t /* count */) {}
+  /**
+   * @brief Destroy the Base Sink object
+   *
+   */
+  virtual ~BaseSink() {}
+};
+
+/**
+ * @brief A sink that writes to a descriptor it does not own. It is also the
+ * base of the sinks that write to a descriptor they own.
+ *
+ */
+class DescriptorSink : public BaseSink {
+ protected:
+  /**
+   * @brief fd the descriptor written to
+   *
+   */
+  int fd;
+
+ public:
+  /**
+   * @brief Construct a new Descriptor Sink object
+   *
+   * @param descriptor the open descriptor to write to.
+   */
+  explicit DescriptorSink(int descriptor) : fd(descriptor) {}
+  /**
+   * @brief Writes all the bytes to the descriptor retrying on partial writes.
+   *
+   * @param data the bytes to write
+   * @param count the number of bytes
+   */
+  void write(char const* data, std::size_t count) override {
+    while (count > 0) {
+#ifndef _WIN32
+      auto done = ::write(fd, data, count);
+#else
+      auto done = ::_write(fd, data, static_cast<unsigned>(count));
+#endif
+      if (done < 0 && errno == EINTR) continue;
+      if (done <= 0)
+        throw testcaser::exceptions::maker::TestFileIOError(
+            "Writing to " + this->name() + " failed : " + strerror(errno));
+      data += done;
+      count -= static_cast<std::size_t>(done);
+    }
+  }
+  /**
+   * @brief The name of the sink
+   *
+   * @return std::string the descriptor as a name
+   */
+  std::string name() const override {
+    return "descriptor " + std::to_string(fd);
+  }
+  /**
+   * @brief The descriptor written to.
+   *
+   * @return int the descriptor
+   */
+  int descriptor() const override { return fd; }
+};
+
+/**
+ * @brief A sink that writes to a file on the disk. This is the sink used when
+ * a TestCaseBuilder is created with a path.
+ *
+ */
+class FileSink final : public DescriptorSink {
+  std::string path;
+
+  void close_descriptor() {
+    if (fd < 0) return;
+#ifndef _WIN32
+    ::close(fd);
+#else
+    ::_close(fd);
+#endif
+    fd = -1;
+  }
+
+ public:
+  FileSink(FileSink const&) = delete;
+  FileSink& operator=(FileSink const&) = delete;
+  /**
+   * @brief Construct a new File Sink object. The file is created or truncated.
+   *
+   * @param abs_name the path of the file to write
+   */
+  explicit FileSink(std::string const& abs_name)
+      : DescriptorSink(-1), path(abs_name) {
+#ifndef _WIN32
+    fd = ::open(abs_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                0666);
+#else
+    fd = ::_open(abs_name.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY,
+                 _S_IREAD | _S_IWRITE);
+#endif
+    if (fd < 0)
+      throw testcaser::exceptions::maker::TestFileIOError(
+          "Unable to open " + abs_name + " : " + strerror(errno));
+  }
+  /**
+   * @brief Closes the file
+   *
+   */
+  void close() override { this->close_descriptor(); }
+  /**
+   * @brief Closes and removes the file
+   *
+   */
+  void discard() override {
+    this->close_descriptor();
+    std::cerr << "Warning : Removing the unfinalized file " + path + "\n";
+    if (std::remove(path.c_str()) != 0)
+      std::cerr << "Failed to remove Unfinalized file " << path;
+  }
+  /**
+   * @brief The path of the file
+   *
+   * @return std::string the path
+   */
+  std::string name() const override { return path; }
+  /**
+   * @brief The file is closed once written. Readers should open the path.
+   *
+   * @return int always -1
+   */
+  int descriptor() const override { return -1; }
+  /**
+   * @brief Destroy the File Sink object
+   *
+   */
+  ~FileSink() { this->close_descriptor(); }
+};
+
+/**
+ * @brief A sink that keeps the test in memory. The test can be accessed with
+ * contents() once the builder is finalized.
+ *
+ */
+class MemorySink final : public BaseSink {
+  std::string data;
+
+ public:
+  /**
+   * @brief Appends the bytes to the memory
+   *
+   * @param bytes the bytes to write
+   * @param count the number of bytes
+   */
+  void write(char const* bytes, std::size_t count) override {
+    data.append(bytes, count);
+  }
+  /**
+   * @brief Throws away the contents
+   *
+   */
+  void discard() override { data.clear(); }
+  /**
+   * @brief The name of the sink
+   *
+   * @return std::string always "memory"
+   */
+  std::string name() const override { return "memory"; }
+  /**
+   * @brief The test written so far.
+   *
+   * @return std::string const& the contents of the test
+   */
+  std::string const& contents() const { return data; }
+};
+
+#ifndef _WIN32
+/**
+ * @brief A sink that maps the test file in memory so that the builder formats
+ * values straight into the file. The file is preallocated to the size hint,
+ * grown in chunks of growth bytes when the hint is exceeded and truncated to
+ * the written length once closed.
+ *
+ */
+class MappedFileSink final : public BaseSink {
+  std::string path;
+  int fd = -1;
+  char* base = nullptr;
+  std::size_t mapped = 0, offset = 0, growth;
+
+  void fail(std::string const& action) {
+    throw testcaser::exceptions::maker::TestFileIOError(
+        action + " " + path + " failed : " + strerror(errno));
+  }
+  void unmap() {
+    if (base != nullptr) ::munmap(base, mapped);
+    base = nullptr;
+  }
+  void close_descriptor() {
+    this->unmap();
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+  }
+  /**
+   * @brief Makes the file and the mapping atleast size bytes long. The old
+   * mapping is released only once the new one is made, so a failure leaves the
+   * memory returned by acquire() valid.
+   *
+   * @param size the new size of the mapping
+   */
+  void map(std::size_t size) {
+    // posix_fallocate reserves the blocks so that running out of disk space
+    // is an error here and not a SIGBUS while formatting
+    int const status = ::posix_fallocate(fd, 0, static_cast<off_t>(size));
+    if (status != 0 && (status != EINVAL && status != EOPNOTSUPP)) {
+      errno = status;
+      this->fail("Preallocating");
+    }
+    if (status != 0 && ::ftruncate(fd, static_cast<off_t>(size)) != 0)
+      this->fail("Resizing");
+    void* memory =
+        ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (memory == MAP_FAILED) this->fail("Mapping");
+    this->unmap();
+    base = static_cast<char*>(memory);
+    mapped = size;
+  }
+
+ public:
+  MappedFileSink(MappedFileSink const&) = delete;
+  MappedFileSink& operator=(MappedFileSink const&) = delete;
+  /**
+   * @brief Construct a new Mapped File Sink object. The file is created or
+   * truncated.
+   *
+   * @param abs_name the path of the file to write
+   * @param size_hint the expected size of the test in bytes
+   * @param growth_bytes how much to grow the file by when the hint is exceeded
+   */
+  explicit MappedFileSink(std::string const& abs_name,
+                          std::size_t size_hint = 1 << 26,
+                          std::size_t growth_bytes = 1 << 26)
+      : path(abs_name), growth(growth_bytes < 4096 ? 4096 : growth_bytes) {
+    fd = ::open(abs_name.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC,
+                0666);
+    if (fd < 0) this->fail("Opening");
+    try {
+      this->map(size_hint < 4096 ? 4096 : size_hint);
+    } catch (...) {
+      this->close_descriptor();
+      throw;
+    }
+  }
+  /**
+   * @brief Grows the file so that atleast bytes more bytes can be written
+   * without remapping. Use it when the size of the rest of the test is known.
+   *
+   * @param bytes the number of bytes that will be written next
+   */
+  void reserve(std::size_t bytes) {
+    if (offset + bytes > mapped) this->map(offset + bytes);
+  }
+  /**
+   * @brief Returns the mapped memory after the written bytes, growing the
+   * mapping when fewer than minimum bytes are left.
+   *
+   * @param minimum the number of bytes needed atleast
+   * @param capacity set to the number of bytes available
+   * @return char* the memory to write into
+   */
+  char* acquire(std::size_t minimum, std::size_t& capacity) override {
+    if (offset + minimum > mapped)
+      this->map(std::max(mapped + growth, offset + minimum));
+    capacity = mapped - offset;
+    return base + offset;
+  }
+  /**
+   * @brief Marks count bytes after the written ones as written.
+   *
+   * @param count the number of bytes
+   */
+  void commit(std::size_t count) override { offset += count; }
+  /**
+   * @brief Copies the bytes into the mapping
+   *
+   * @param data the bytes to write
+   * @param count the number of bytes
+   */
+  void write(char const* data, std::size_t count) override {
+    std::size_t capacity;
+    std::copy(data, data + count, this->acquire(count, capacity));
+    this->commit(count);
+  }
+  /**
+   * @brief Unmaps and truncates the file to the written length
+   *
+   */
+  void close() override {
+    if (fd < 0) return;
+    this->unmap();
+    int const status = ::ftruncate(fd, static_cast<off_t>(offset));
+    int const reason = errno;
+    this->close_descriptor();
+    if (status != 0) {
+      errno = reason;
+      this->fail("Truncating");
+    }
+  }
+  /**
+   * @brief Closes and removes the file
+   *
+   */
+  void discard() override {
+    this->close_descriptor();
+    std::cerr << "Warning : Removing the unfinalized file " + path + "\n";
+    if (std::remove(path.c_str()) != 0)
+      std::cerr << "Failed to remove Unfinalized file " << path;
+  }
+  /**
+   * @brief The path of the file
+   *
+   * @return std::string the path
+   */
+  std::string name() const override { return path; }
+  /**
+   * @brief The number of bytes written so far
+   *
+   * @return std::size_t the length of the test
+   */
+  std::size_t size() const { return offset; }
+  /**
+   * @brief Destroy the Mapped File Sink object
+   *
+   */
+  ~MappedFileSink() { this->close_descriptor(); }
+};
+#endif
+
+#ifdef __linux__
+/**
+ * @brief A sink that writes to an anonymous in-memory file created with
+ * memfd_create. The descriptor can be handed to the VirtualJudge which feeds it
+ * straight to the program, without the test ever touching the disk. If
+ * memfd_create is not available an unlinked temporary file is used.
+ *
+ */
+class MemfdSink final : public DescriptorSink {
+ public:
+  MemfdSink(MemfdSink const&) = delete;
+  MemfdSink& operator=(MemfdSink const&) = delete;
+  /**
+   * @brief Construct a new Memfd Sink object
+   *
+   * @param label the name of the anonymous file shown in /proc/<pid>/fd
+   */
+  explicit MemfdSink(std::string const& label = "testcaser")
+      : DescriptorSink(-1) {
+#ifdef SYS_memfd_create
+    // MFD_CLOEXEC, the judge dup2's it on the program's stdin explicitly
+    fd = static_cast<int>(::syscall(SYS_memfd_create, label.c_str(), 1u));
+#endif
+    if (fd < 0) {
+      FILE* tmp = ::tmpfile();
+      if (tmp != nullptr) {
+        // a close on exec copy, as the memfd, so no program inherits it
+        fd = ::fcntl(::fileno(tmp), F_DUPFD_CLOEXEC, 0);
+        int const reason = errno;
+        ::fclose(tmp);
+        errno = reason;
+      }
+    }
+    if (fd < 0)
+      throw testcaser::exceptions::maker::TestFileIOError(
+          "Unable to create the in-memory file " + label + " : " +
+          strerror(errno));
+  }
+  /**
+   * @brief Drops the contents of the file
+   *
+   */
+  void discard() override {
+    if (::ftruncate(fd, 0) != 0)
+      std::cerr << "Failed to discard in-memory file " << this->name();
+  }
+  /**
+   * @brief The name of the sink
+   *
+   * @return std::string the descriptor as a name
+   */
+  std::string name() const override {
+    return "memfd " + std::to_string(fd);
+  }
+  /**
+   * @brief Destroy the Memfd Sink object
+   *
+   */
+  ~MemfdSink() { ::close(fd); }
+};
+#endif
+}  // namespace sinks
+}  // namespace maker
+}  // namespace testcaser
+#endif
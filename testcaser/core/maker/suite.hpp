@@ -0,0 +1,207 @@
+/**
+ *   Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef SUITE_HPP
+#define SUITE_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <string>
+#include <testcaser/core/maker/builder.hpp>
+#include <testcaser/core/maker/pool.hpp>
+#include <testcaser/core/maker/randoms/seeding.hpp>
+#include <vector>
+
+namespace testcaser {
+namespace maker {
+/**
+ * @brief What the TestSuiteBuilder reports about a single file of the suite.
+ *
+ */
+struct FileReport {
+  /**
+   * @brief path the path of the file
+   *
+   */
+  std::string path;
+  /**
+   * @brief bytes the length of the file
+   *
+   */
+  std::size_t bytes = 0;
+  /**
+   * @brief seconds the time taken to generate and write the file
+   *
+   */
+  double seconds = 0;
+  /**
+   * @brief error the exception that stopped the file, nullptr on success. A
+   * failed file is removed.
+   *
+   */
+  std::exception_ptr error;
+};
+
+/**
+ * @brief A single file of the suite handed to the generation callback.
+ *
+ * @tparam Params the type of the parameters of a file
+ */
+template <class Params>
+class SuiteFile {
+  std::size_t position;
+  unsigned long long base_seed;
+  Params const& parameters;
+  TestCaseBuilder& output;
+
+ public:
+  /**
+   * @brief Construct a new Suite File object
+   *
+   * @param idx the index of the file in the suite
+   * @param seed the seed of the file
+   * @param params the parameters of the file
+   * @param builder the builder of the file
+   */
+  SuiteFile(std::size_t idx, unsigned long long seed, Params const& params,
+            TestCaseBuilder& builder)
+      : position(idx), base_seed(seed), parameters(params), output(builder) {}
+  /**
+   * @brief The index of the file in the suite.
+   *
+   * @return std::size_t the index
+   */
+  std::size_t index() const { return position; }
+  /**
+   * @brief The seed of the stream-th random object of this file.
+   *
+   * @param stream the number of the random object in the file
+   * @return unsigned long long the seed to reseed_engine(..) it with
+   */
+  unsigned long long seed(std::size_t stream = 0) const {
+    return seeding::derive(base_seed, stream);
+  }
+  /**
+   * @brief The parameters the file was added with.
+   *
+   * @return Params const& the parameters
+   */
+  Params const& params() const { return parameters; }
+  /**
+   * @brief The builder to write the file with. It is finalized by the suite
+   * once the callback returns.
+   *
+   * @return TestCaseBuilder& the builder of this file
+   */
+  TestCaseBuilder& builder() { return output; }
+};
+
+/**
+ * @brief Generates many test files concurrently on a WorkStealingPool. Every
+ * file is written by its own TestCaseBuilder with seeds derived from the master
+ * seed and the index of the file, so a suite is reproduced from one number
+ * whatever the number of threads.
+ *
+ * @tparam Params the type of the parameters of a file
+ */
+template <class Params>
+class TestSuiteBuilder {
+  struct Entry {
+    std::string path;
+    Params params;
+  };
+  unsigned long long master_seed;
+  std::vector<Entry> files;
+
+ public:
+  /**
+   * @brief The callback that writes a single file.
+   *
+   */
+  typedef std::function<void(SuiteFile<Params>&)> Generator;
+  /**
+   * @brief Construct a new Test Suite Builder object
+   *
+   * @param seed the master seed all the file seeds are derived from
+   */
+  explicit TestSuiteBuilder(unsigned long long seed) : master_seed(seed) {}
+  /**
+   * @brief Adds a file to the suite.
+   *
+   * @param abs_name The Absolute name of the testfile to generate.
+   * @param params the parameters handed to the callback for this file
+   * @return TestSuiteBuilder& this builder
+   */
+  TestSuiteBuilder& add_file(std::string const& abs_name,
+                             Params const& params) {
+    files.push_back(Entry{abs_name, params});
+    return *this;
+  }
+  /**
+   * @brief Generates all the files of the suite. A file whose callback throws
+   * is removed by its TestCaseBuilder and its report carries the error, the
+   * other files are still generated.
+   *
+   * @param generate the callback that writes a file
+   * @param pool the pool to run the files on
+   * @return std::vector<FileReport> the reports in the order files were added
+   */
+  std::vector<FileReport> build(Generator const& generate,
+                                WorkStealingPool& pool) const {
+    std::vector<FileReport> reports(files.size());
+    for (std::size_t t = 0; t < files.size(); t++) {
+      Entry const& entry = files[t];
+      FileReport& report = reports[t];
+      unsigned long long const seed = seeding::derive(master_seed, t);
+      pool.submit([&entry, &report, &generate, seed, t] {
+        auto const start = std::chrono::steady_clock::now();
+        report.path = entry.path;
+        try {
+          TestCaseBuilder builder(entry.path);
+          builder.set_verbose(false);
+          SuiteFile<Params> file(t, seed, entry.params, builder);
+          generate(file);
+          builder.finalize();
+          report.bytes = builder.bytes_written();
+        } catch (...) {
+          report.error = std::current_exception();
+        }
+        report.seconds = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+      });
+    }
+    pool.wait();
+    return reports;
+  }
+  /**
+   * @brief Generates all the files of the suite on a pool of its own.
+   *
+   * @param generate the callback that writes a file
+   * @param threads the number of threads, 0 for one per core
+   * @return std::vector<FileReport> the reports in the order files were added
+   */
+  std::vector<FileReport> build(Generator const& generate,
+                                unsigned threads = 0) const {
+    WorkStealingPool pool(threads);
+    return this->build(generate, pool);
+  }
+};
+}  // namespace maker
+}  // namespace testcaser
+#endif
@@ -0,0 +1,89 @@
+/**
+ *   Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/**
+ * Writes an array of N random values once with a add(..)/add_space() loop and
+ * once with add_array(..) and reports the time taken by both. A binary grid
+ * is then written digit by digit and row by row with add_digits(..).
+ */
+
+#include <chrono>
+#include <iostream>
+#include <testcaser/maker>
+
+using std::cout;
+using std::endl;
+
+using testcaser::maker::TestCaseBuilder;
+using testcaser::maker::types::RandomBinary;
+using testcaser::maker::types::RandomUnsignedInteger;
+
+int main() {
+  const std::size_t count = 10000000;
+  RandomUnsignedInteger<> value{{1, 1000000001}};
+
+  auto start = std::chrono::steady_clock::now();
+  {
+    TestCaseBuilder builder("./bulk-bench-loop.txt");
+    builder.add_character('0' + 0);
+    builder.add_line();
+    for (std::size_t t = 0; t < count; t++) {
+      builder.add(value);
+      builder.add_space();
+    }
+    builder.add_line();
+    builder.finalize();
+  }
+  auto mid = std::chrono::steady_clock::now();
+  {
+    TestCaseBuilder builder("./bulk-bench-array.txt");
+    builder.add_array(value, count);
+    builder.finalize();
+  }
+  auto stop = std::chrono::steady_clock::now();
+
+  cout << "add(..) loop : " << std::chrono::duration<double>(mid - start).count()
+       << " s" << endl;
+  cout << "add_array    : "
+       << std::chrono::duration<double>(stop - mid).count() << " s" << endl;
+
+  const std::size_t side = 4000;
+  RandomBinary<> bin;
+  start = std::chrono::steady_clock::now();
+  {
+    TestCaseBuilder builder("./bulk-bench-loop.txt");
+    for (std::size_t i = 0; i < side; i++) {
+      for (std::size_t j = 0; j < side; j++) builder.add(bin);
+      builder.add_line();
+    }
+    builder.finalize();
+  }
+  mid = std::chrono::steady_clock::now();
+  {
+    TestCaseBuilder builder("./bulk-bench-array.txt");
+    for (std::size_t i = 0; i < side; i++) builder.add_digits(bin, side);
+    builder.finalize();
+  }
+  stop = std::chrono::steady_clock::now();
+
+  cout << "binary grid add(..) : "
+       << std::chrono::duration<double>(mid - start).count() << " s" << endl;
+  cout << "binary grid rows    : "
+       << std::chrono::duration<double>(stop - mid).count() << " s" << endl;
+  std::remove("./bulk-bench-loop.txt");
+  std::remove("./bulk-bench-array.txt");
+  return 0;
+}
@@ -0,0 +1,168 @@
+/**
+ *   Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <testcaser/core/maker/randoms/RandomTypes.hpp>
+#include <testcaser/core/maker/randoms/distributions.hpp>
+#include <testcaser/core/maker/randoms/engines.hpp>
+
+using std::cout;
+using std::endl;
+
+using testcaser::maker::distributions::BoundedInteger;
+using testcaser::maker::distributions::Exponential;
+using testcaser::maker::distributions::Geometric;
+using testcaser::maker::distributions::Normal;
+using testcaser::maker::distributions::Poisson;
+using testcaser::maker::distributions::Zipf;
+using testcaser::maker::engines::Philox4x32;
+using testcaser::maker::engines::Xoshiro256;
+using testcaser::maker::engines::Xoshiro256x4;
+using testcaser::maker::types::RandomInteger;
+using testcaser::maker::types::RandomNormal;
+using testcaser::maker::types::RandomZipf;
+
+template <class T, class Engine>
+bool in_bounds(T a, T b, Engine& engine) {
+  BoundedInteger<T> dist(a, b);
+  for (int t = 0; t < 100000; t++) {
+    T const value = dist(engine);
+    if (value < a || value > b) return false;
+  }
+  return true;
+}
+
+// fill(..) must give the values of count calls of operator(), rejections
+// included, and leave the engine at the same position
+template <class Engine>
+bool fill_matches(unsigned long long a, unsigned long long b) {
+  BoundedInteger<unsigned long long> dist(a, b);
+  Engine filled(2019), stepped(2019);
+  unsigned long long values[1000];
+  dist.fill(filled, values, 7);
+  dist.fill(filled, values + 7, 993);
+  for (int t = 0; t < 1000; t++)
+    if (values[t] != dist(stepped)) return false;
+  return filled() == stepped();
+}
+
+// prints the mean and the variance of the values next to the expected ones
+template <class Distribution, class Engine>
+void moments(char const* name, Distribution const& dist, Engine& engine,
+             double mean, double variance) {
+  double sum = 0, squares = 0;
+  const int draws = 1000000;
+  for (int t = 0; t < draws; t++) {
+    double const value = static_cast<double>(dist(engine));
+    sum += value;
+    squares += value * value;
+  }
+  double const m = sum / draws;
+  cout << name << " mean " << m << " (" << mean << ") variance "
+       << squares / draws - m * m << " (" << variance << ")" << endl;
+}
+
+int main() {
+  std::mt19937 mt(2019);
+  Xoshiro256 xs(2019);
+  std::minstd_rand minstd(2019);
+  cout << "Small range in bounds : " << in_bounds<int>(-3, 3, mt)
+       << in_bounds<int>(-3, 3, xs) << in_bounds<int>(-3, 3, minstd) << endl;
+  cout << "32 bit range in bounds : "
+       << in_bounds<unsigned long long>(0, 0xFFFFFFFFull, mt)
+       << in_bounds<unsigned long long>(5, 0x100000004ull, mt) << endl;
+  cout << "64 bit range in bounds : "
+       << in_bounds<long long>(-__LONG_LONG_MAX__ - 1, __LONG_LONG_MAX__, mt)
+       << in_bounds<long long>(-__LONG_LONG_MAX__, 7, minstd) << endl;
+
+  cout << "fill(..) matches operator() : "
+       << fill_matches<std::mt19937>(0, 9)
+       << fill_matches<std::mt19937>(0, 0xBFFFFFFFull)
+       << fill_matches<Philox4x32>(0, 0xBFFFFFFFFFFFFFFFull)
+       << fill_matches<Xoshiro256x4>(0, 0xBFFFFFFFull)
+       << fill_matches<std::minstd_rand>(0, ~0ull) << endl;
+
+  // every value of a range of 6 should be hit about 1/6 of the times
+  long long hits[6] = {0, 0, 0, 0, 0, 0};
+  BoundedInteger<int> die(1, 6);
+  for (int t = 0; t < 600000; t++) hits[die(mt) - 1]++;
+  cout << "Die hits :";
+  for (int t = 0; t < 6; t++) cout << " " << hits[t];
+  cout << endl;
+
+  // the output is specified, these values are the same with every compiler
+  RandomInteger<Philox4x32> value{{-1000, 1000}};
+  value.reseed_engine(7);
+  cout << "Values of seed 7 :";
+  for (int t = 0; t < 5; t++) cout << " " << value.get();
+  cout << endl;
+
+  moments("Normal(5, 2)", Normal(5, 2), xs, 5, 4);
+  moments("Exponential(0.5)", Exponential(0.5), xs, 2, 4);
+  moments("Geometric(0.25)", Geometric(0.25), xs, 3, 12);
+  moments("Poisson(3)", Poisson(3), xs, 3, 3);
+  moments("Poisson(1000)", Poisson(1000), xs, 1000, 1000);
+
+  // rank k of Zipf(n, 1) is drawn about 1 / k as often as rank 1
+  long long ranks[4] = {0, 0, 0, 0};
+  Zipf zipf(1000000, 1);
+  for (int t = 0; t < 1000000; t++) {
+    long long const rank = zipf(xs);
+    if (rank < 1 || rank > 1000000) cout << "Zipf rank out of range" << endl;
+    if (rank <= 4) ranks[rank - 1]++;
+  }
+  cout << "Zipf ranks 1 2 3 4 (about 1 1/2 1/3 1/4) :";
+  for (int t = 0; t < 4; t++) cout << " " << ranks[t];
+  cout << endl;
+
+  // values are rounded and clamped to the nearest allowed value
+  testcaser::maker::RandomIntegerLimit limit{-3, 4};
+  limit.add_interval_exception({0, 2});
+  RandomNormal<> clamped(0, 100, limit);
+  bool allowed = true;
+  for (int t = 0; t < 10000; t++) allowed &= limit.valid_output(clamped.get());
+  cout << "Normal values are clamped to the limit : " << allowed
+       << limit.clamp(-10) << limit.clamp(0) << limit.clamp(1)
+       << limit.clamp(10) << endl;
+
+  const int draws = 20000000;
+  std::uniform_int_distribution<long long> standard(1, 1000000000);
+  BoundedInteger<long long> bounded(1, 1000000000);
+  long long sum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int t = 0; t < draws; t++) sum += standard(mt);
+  auto mid = std::chrono::steady_clock::now();
+  for (int t = 0; t < draws; t++) sum += bounded(mt);
+  auto stop = std::chrono::steady_clock::now();
+  cout << "std::uniform_int_distribution : "
+       << std::chrono::duration<double>(mid - start).count() << " s" << endl;
+  cout << "BoundedInteger                : "
+       << std::chrono::duration<double>(stop - mid).count() << " s (" << sum % 10
+       << ")" << endl;
+  RandomZipf<Xoshiro256> keys(1000000000, 0.99);
+  std::vector<long long> batch(4096);
+  start = std::chrono::steady_clock::now();
+  for (int t = 0; t < draws; t += 4096) keys.fill(batch.data(), 4096);
+  stop = std::chrono::steady_clock::now();
+  cout << "RandomZipf of 10^9 keys       : "
+       << std::chrono::duration<double>(stop - start).count() << " s" << endl;
+  return 0;
+}
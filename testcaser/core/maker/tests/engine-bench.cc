@@ -0,0 +1,85 @@
+/**
+ *   Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/**
+ * Compares the engines of the maker against std::mt19937 through the
+ * RandomUnsignedInteger wrapper. Reports the size of the engine and of the
+ * wrapper, the time to construct many wrappers, the time to draw values one by
+ * one and the time to draw them in bulk with fill(..).
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <testcaser/core/maker/randoms/RandomTypes.hpp>
+#include <testcaser/core/maker/randoms/engines.hpp>
+#include <vector>
+
+using std::cout;
+using std::endl;
+
+using testcaser::maker::types::RandomUnsignedInteger;
+namespace engines = testcaser::maker::engines;
+
+template <class Engine>
+void bench(std::string const& name) {
+  const std::size_t objects = 10000, draws = 20000000;
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<RandomUnsignedInteger<Engine>> many;
+  many.reserve(objects);
+  for (std::size_t t = 0; t < objects; t++) many.emplace_back(
+      RandomUnsignedInteger<Engine>{{1, 1000000001}});
+  auto mid = std::chrono::steady_clock::now();
+
+  RandomUnsignedInteger<Engine> value{{1, 1000000001}};
+  std::vector<unsigned long long> bulk(draws);
+  unsigned long long sink = 0;
+  for (std::size_t t = 0; t < draws; t++) sink += value.get();
+  auto stop = std::chrono::steady_clock::now();
+
+  value.fill(bulk.data(), bulk.size());
+  sink += bulk[draws / 2];
+  auto filled = std::chrono::steady_clock::now();
+
+  double const construct =
+      std::chrono::duration<double, std::micro>(mid - start).count() / objects;
+  double const draw =
+      std::chrono::duration<double, std::nano>(stop - mid).count() / draws;
+  double const fill =
+      std::chrono::duration<double, std::nano>(filled - stop).count() / draws;
+  cout << std::left << std::setw(14) << name << std::setw(10) << sizeof(Engine)
+       << std::setw(10) << sizeof(RandomUnsignedInteger<Engine>)
+       << std::setw(16) << construct << std::setw(12) << draw
+       << std::setw(12) << fill << "("
+       << sink % 10 << ")" << endl;
+}
+
+int main() {
+  cout << std::left << std::setw(14) << "engine" << std::setw(10) << "bytes"
+       << std::setw(10) << "wrapper" << std::setw(16) << "construct us"
+       << std::setw(12) << "draw ns" << std::setw(12) << "fill ns" << endl;
+  bench<std::mt19937>("mt19937");
+  bench<std::mt19937_64>("mt19937_64");
+  bench<engines::Philox4x32>("Philox4x32");
+  bench<engines::Xoshiro256>("Xoshiro256");
+  bench<engines::Xoshiro256x4>("Xoshiro256x4");
+  bench<engines::PCG64>("PCG64");
+  bench<engines::WyRand>("WyRand");
+  return 0;
+}
@@ -0,0 +1,104 @@
+/**
+ *   Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <testcaser/core/maker/randoms/RandomTypes.hpp>
+#include <testcaser/core/maker/randoms/engines.hpp>
+
+using std::cout;
+using std::endl;
+
+using testcaser::maker::engines::PCG64;
+using testcaser::maker::engines::Philox4x32;
+using testcaser::maker::engines::Xoshiro256;
+using testcaser::maker::engines::Xoshiro256x4;
+using testcaser::maker::types::RandomAlphabet;
+using testcaser::maker::types::RandomBinary;
+using testcaser::maker::types::RandomInteger;
+
+int main() {
+  // known answer of Philox4x32-10 for a zero key and counter
+  Philox4x32 zero(0);
+  cout << "Known answer : " << std::hex;
+  for (int t = 0; t < 4; t++) cout << zero() << " ";
+  cout << "(expected 6627e8d5 e169c58d bc57ac4c 9b00dbd8)" << std::dec << endl;
+
+  Philox4x32 stepped(2019, 3), jumped(2019, 3);
+  for (int t = 0; t < 1000003; t++) stepped();
+  jumped.discard(1000003);
+  cout << "discard(..) matches stepping : " << (stepped() == jumped()) << endl;
+
+  Philox4x32 streamed(2019);
+  streamed.seek(3, 1000004);
+  cout << "seek(..) matches stepping : " << (stepped() == streamed()) << endl;
+
+  // known answer of pcg64 for the seed 42 and the stream 54
+  PCG64 pcg(42, 54);
+  unsigned long long const pcg_first = pcg(), pcg_second = pcg();
+  cout << "PCG64 known answer : " << std::hex << pcg_first << " " << pcg_second
+       << " (expected 86b1da1d72062b68 1304aa46c9853d39)" << std::dec << endl;
+  PCG64 pcg_stepped(5, 3), pcg_jumped(5, 3);
+  for (int t = 0; t < 12345; t++) pcg_stepped();
+  pcg_jumped.discard(12345);
+  cout << "PCG64 discard(..) matches stepping : "
+       << (pcg_stepped() == pcg_jumped()) << endl;
+
+  Xoshiro256 first_half(11), second_half(11);
+  second_half.jump();
+  cout << "Xoshiro256 jump() moves the engine : "
+       << (first_half != second_half) << endl;
+
+  Xoshiro256x4 lanes(11), stepped_lanes(11);
+  Xoshiro256 lane(11);
+  std::uint64_t bulk[1003];
+  lanes.fill(bulk, 3);
+  lanes.fill(bulk + 3, 1000);
+  bool lanes_match = true;
+  for (int t = 0; t < 1003; t++) {
+    lanes_match = lanes_match && bulk[t] == stepped_lanes();
+    if (t % 4 == 0) lanes_match = lanes_match && bulk[t] == lane();
+  }
+  cout << "Xoshiro256x4 fill(..) matches stepping and lane 0 : "
+       << lanes_match << endl;
+
+  RandomInteger<Philox4x32> value{{-100, 100}};
+  value.get_engine().seed(7, 42);
+  long long first[5];
+  value.fill(first, 5);
+  value.get_engine().seek(42, 0);
+  bool same = true;
+  for (int t = 0; t < 5; t++) same = same && value.get() == first[t];
+  cout << "RandomInteger regenerates a stream : " << same << endl;
+
+  // a whole script driven by one engine is reproduced from its seed
+  std::string scripts[2];
+  for (int run = 0; run < 2; run++) {
+    auto engine = std::make_shared<std::mt19937>(2019);
+    RandomInteger<> number({{1, 1000}}, engine);
+    RandomAlphabet<> letter(engine);
+    RandomBinary<> bit(engine);
+    for (int t = 0; t < 10; t++)
+      scripts[run] += std::to_string(number.get()) + letter.get() +
+                      std::to_string(bit.get_as_int());
+  }
+  cout << "A shared engine reproduces a script : "
+       << (scripts[0] == scripts[1]) << endl;
+  return 0;
+}
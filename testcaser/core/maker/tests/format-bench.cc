@@ -0,0 +1,74 @@
+/**
+ *   Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/**
+ * Compares the old std::to_string + std::string::append path with the
+ * formatting layer used by the TestCaseBuilder. Both paths format the same
+ * values and the outputs are checked to be identical.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <testcaser/core/maker/format.hpp>
+#include <vector>
+
+using std::cout;
+using std::endl;
+
+namespace format = testcaser::maker::format;
+
+int main() {
+  const std::size_t count = 10000000;
+  std::mt19937_64 gen(42);
+  std::vector<long long> values(count);
+  for (auto& v : values) v = static_cast<long long>(gen()) >> (gen() % 63);
+
+  auto start = std::chrono::steady_clock::now();
+  std::string old_path;
+  for (auto v : values) {
+    if (old_path.size() >= 4096) old_path.clear();
+    old_path += std::to_string(v);
+    old_path += ' ';
+  }
+  auto mid = std::chrono::steady_clock::now();
+  std::vector<char> new_path(4096 + format::max_integral_length + 1);
+  std::size_t used = 0;
+  for (auto v : values) {
+    if (used >= 4096) used = 0;
+    used += format::write(new_path.data() + used, v);
+    new_path[used++] = ' ';
+  }
+  auto stop = std::chrono::steady_clock::now();
+
+  std::string a, b;
+  for (std::size_t t = 0; t < 1000; t++) {
+    char buf[format::max_integral_length];
+    a += std::to_string(values[t]);
+    b.append(buf, format::write(buf, values[t]));
+  }
+  char buf[format::max_integral_length];
+  std::string edge(buf, format::write(buf, -__LONG_LONG_MAX__ - 1));
+
+  cout << "std::to_string path : "
+       << std::chrono::duration<double>(mid - start).count() << " s" << endl;
+  cout << "format path         : "
+       << std::chrono::duration<double>(stop - mid).count() << " s" << endl;
+  cout << "Outputs match       : "
+       << (a == b && edge == std::to_string(-__LONG_LONG_MAX__ - 1)) << endl;
+  return 0;
+}
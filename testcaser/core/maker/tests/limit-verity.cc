@@ -27,6 +27,7 @@ using std::endl;
 using testcaser::maker::RandomCharacterLimit;
 using testcaser::maker::RandomIntegerLimit;
 using testcaser::maker::RandomUnsignedIntegerLimit;
+using testcaser::maker::StaticLimit;
 
 int main() {
   RandomIntegerLimit lt(50, -10);
@@ -53,6 +54,44 @@ int main() {
   cout << "Is valid : " << lt3.valid_output('B') << endl;
   cout << "Is valid : " << lt3.valid_output('A') << endl;
 
+  RandomIntegerLimit sparse(100, 0);
+  for (long long t = 0; t < 100; t += 10)
+    sparse.add_interval_exception({t, t + 9});
+  auto allowed = sparse.allowed_ranges();
+  cout << "Allowed values of a 90% excluded limit : " << allowed.size() << endl;
+  cout << "The allowed values :";
+  for (unsigned long long t = 0; t < allowed.size(); t++)
+    cout << " " << allowed.at(t);
+  cout << endl;
+  cout << "Allowed values less than 35 : " << allowed.rank(35) << endl;
+
+  RandomIntegerLimit merged(100, 0);
+  merged.add_interval_exception({10, 20});
+  merged.add_interval_exception({15, 30});
+  merged.add_interval_exception({30, 35});
+  merged.add_point_exceptions({5, 6, 7, 50, 12, 99});
+  merged.add_point_exception(36);
+  cout << "Size after overlapping exceptions : " << merged.actual_limit_size()
+       << " (expected 69)" << endl;
+  cout << "Allowed intervals after merging : "
+       << merged.allowed_ranges().intervals().size() << " (expected 5)" << endl;
+  cout << "Is valid : " << merged.valid_output(36) << merged.valid_output(37)
+       << merged.valid_output(98) << merged.valid_output(99) << endl;
+
+  typedef StaticLimit<int, 0, 10, 3, 4, 8> Sparse;
+  static_assert(Sparse::size() == 7, "3, 4 and 8 are excluded");
+  static_assert(Sparse::at(3) == 5 && Sparse::at(6) == 9, "excluded skipped");
+  typedef StaticLimit<int, 5, 10, 2, 7, 12> Outside;
+  static_assert(Outside::size() == 4 && Outside::at(0) == 5 &&
+                    Outside::at(3) == 9,
+                "points outside the limit are ignored");
+  static_assert(testcaser::maker::limits::StaticAlphabet::at(26) == 'a',
+                "the lower case alphabets follow the upper case ones");
+  cout << "Static limit values :";
+  for (unsigned long long t = 0; t < Sparse::size(); t++)
+    cout << " " << Sparse::at(t);
+  cout << endl;
+
   cout << "Is Copy constructible RandomCharacterLimit: "
        << std::is_copy_constructible<RandomCharacterLimit>::value << endl;
   cout << "Is Move constructible RandomCharacterLimit: "
@@ -31,6 +31,7 @@ using testcaser::maker::types::RandomQuinary;
 using testcaser::maker::types::RandomSenary;
 using testcaser::maker::types::RandomTernary;
 using testcaser::maker::types::RandomUnsignedInteger;
+using testcaser::maker::types::RandomWeightedFrom;
 
 using testcaser::maker::types::RandomType;
 
@@ -47,5 +48,37 @@ int main() {
   auto v = std::vector<char>({'&', '$', '#', ')'});
   RandomFrom<char> i(v);
   for (int t = 0; t < 5; t++) cout << " " << i.get();
+
+  // mostly small numbers with rare huge ones
+  RandomWeightedFrom<int> skewed({1, 10, 1000000}, {90, 9, 1});
+  long long hits[3] = {0, 0, 0};
+  for (int t = 0; t < 1000000; t++) {
+    int const value = skewed.get();
+    hits[value == 1 ? 0 : value == 10 ? 1 : 2]++;
+  }
+  cout << "\nWeighted hits (about 900000 90000 10000) :";
+  for (int t = 0; t < 3; t++) cout << " " << hits[t];
+  skewed.set_weight(0, 0);
+  int picked[64];
+  skewed.fill(picked, 64);
+  bool never = true;
+  for (int t = 0; t < 64; t++) never = never && picked[t] != 1;
+  cout << "\nZero weight is never picked : " << never;
+
+  // a weight changed before every draw, as a process dropping what it picked
+  RandomWeightedFrom<int> shifting({0, 1, 2, 3}, {1, 1, 1, 1});
+  long long shifted[4] = {0, 0, 0, 0};
+  for (int t = 0; t < 400000; t++) {
+    shifting.set_weight(t % 2, t % 2 == 0 ? 0 : 2);
+    shifted[shifting.get()]++;
+  }
+  cout << "\nInterleaved hits (about 0 200000 100000 100000) :";
+  for (int t = 0; t < 4; t++) cout << " " << shifted[t];
+  try {
+    RandomWeightedFrom<int> invalid({1, 2}, {1});
+  } catch (testcaser::exceptions::maker::WeightError const&) {
+    cout << "\nMismatched weights throw WeightError";
+  }
+  cout << endl;
   return 0;
 }
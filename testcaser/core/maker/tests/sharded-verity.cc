@@ -0,0 +1,64 @@
+/**
+ *   Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <testcaser/core/maker/sharded.hpp>
+
+using std::cout;
+using std::endl;
+
+using testcaser::maker::Segment;
+using testcaser::maker::ShardedBuilder;
+using testcaser::maker::sinks::MemorySink;
+using testcaser::maker::types::RandomUnsignedInteger;
+
+std::string generate(unsigned threads) {
+  auto memory = std::make_shared<MemorySink>();
+  ShardedBuilder sharded(memory, 42);
+  sharded.add_segment([](Segment& segment) {
+    segment.builder().add_raw("64\n");
+  });
+  sharded.add_segments(64, [](Segment& segment) {
+    RandomUnsignedInteger<> value{{1, 1000000}};
+    value.reseed_engine(segment.seed(0));
+    segment.builder().add_array(value, 10000);
+  });
+  sharded.build(threads);
+  return memory->contents();
+}
+
+int main() {
+  std::string const single = generate(1);
+  cout << "Length of the test : " << single.size() << endl;
+  cout << "Identical with 4 threads : " << (single == generate(4)) << endl;
+  cout << "Identical with 16 threads : " << (single == generate(16)) << endl;
+
+  auto failed = std::make_shared<MemorySink>();
+  ShardedBuilder sharded(failed, 42);
+  sharded.add_segments(8, [](Segment& segment) {
+    if (segment.index() == 5) throw std::runtime_error("segment 5 failed");
+    segment.builder().add_raw("ok\n");
+  });
+  try {
+    sharded.build(3);
+  } catch (std::exception const& e) {
+    cout << "Rethrown : " << e.what() << endl;
+  }
+  cout << "Failed test is discarded : " << failed->contents().empty() << endl;
+  return 0;
+}
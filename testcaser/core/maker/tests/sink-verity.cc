@@ -0,0 +1,205 @@
+/**
+ *   Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef _WIN32
+#include <signal.h>
+#include <sys/resource.h>
+#endif
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <testcaser/core/maker/builder.hpp>
+#include <testcaser/core/maker/randoms/corpus.hpp>
+#include <testcaser/core/maker/sinks.hpp>
+
+using std::cout;
+using std::endl;
+
+using testcaser::maker::TestCaseBuilder;
+using testcaser::maker::Corpus;
+using testcaser::maker::sinks::MemorySink;
+using testcaser::maker::types::RandomBinary;
+using testcaser::maker::types::RandomFromView;
+using testcaser::maker::types::RandomTernary;
+using testcaser::maker::types::RandomToken;
+using testcaser::maker::types::RandomUnsignedInteger;
+
+// a sink whose first write fails, as on a full disk
+struct FailingSink : testcaser::maker::sinks::BaseSink {
+  int writes = 0;
+  void write(char const*, std::size_t count) override {
+    if (count > 0 && ++writes == 1) throw std::runtime_error("disk full");
+  }
+  std::string name() const override { return "failing"; }
+};
+
+int main() {
+  RandomUnsignedInteger<> value{{1, 10}};
+  auto memory = std::make_shared<MemorySink>();
+  {
+    TestCaseBuilder builder(memory);
+    builder.add_array(value, 5);
+    builder.finalize();
+  }
+  cout << "Memory contents : " << memory->contents();
+
+  auto discarded = std::make_shared<MemorySink>();
+  {
+    TestCaseBuilder builder(discarded);
+    builder.add_array(value, 5);
+  }
+  cout << "Unfinalized memory is empty : " << discarded->contents().empty()
+       << endl;
+
+  RandomBinary<> bits;
+  RandomTernary<> trits(true);
+  auto digits = std::make_shared<MemorySink>();
+  {
+    TestCaseBuilder builder(digits);
+    builder.add_digits(bits, 10000);
+    builder.add_digits(trits, 100);
+    builder.finalize();
+  }
+  std::string const grid = digits->contents();
+  cout << "Digit rows : " << grid.size() << " bytes (expected 10102), "
+       << (grid.find_first_not_of("01", 0) == 10000) << " "
+       << (grid.find_first_not_of("123", 10001) == 10101) << endl;
+
+  {
+    std::ofstream words("./corpus.txt", std::ios::binary);
+    words << "apple\n\nbanana\r\ncherry";
+  }
+  auto corpus = std::make_shared<Corpus const>("./corpus.txt");
+  cout << "Corpus tokens : " << corpus->size() << " " << (*corpus)[0] << " "
+       << (*corpus)[1] << " " << (*corpus)[2] << endl;
+  RandomToken<> token(corpus);
+  auto tokens = std::make_shared<MemorySink>();
+  {
+    TestCaseBuilder builder(tokens);
+    builder.add_n(token, 200);
+    builder.finalize();
+  }
+  std::string const row = tokens->contents();
+  cout << "Token row is made of the corpus : "
+       << (row.find_first_not_of("abcehlnpry \n") == std::string::npos &&
+           row.back() == '\n')
+       << endl;
+  std::remove("./corpus.txt");
+
+  static int const primes[] = {2, 3, 5, 7};
+  RandomFromView<int> view(primes, 4);
+  auto pool = std::make_shared<std::vector<int> const>(primes, primes + 4);
+  RandomFromView<int> shared(pool, view.share_engine());
+  auto picks = std::make_shared<MemorySink>();
+  {
+    TestCaseBuilder builder(picks);
+    builder.add_n(view, 100);
+    builder.add_n(shared, 100);
+    builder.finalize();
+  }
+  cout << "Views pick from their pools : "
+       << (picks->contents().find_first_not_of("2357 \n") ==
+           std::string::npos)
+       << endl;
+
+#ifndef _WIN32
+  {
+    TestCaseBuilder builder("./mapped.txt", 4096);
+    builder.add_array(value, 5000);
+    builder.finalize();
+  }
+  std::ifstream mapped("./mapped.txt", std::ios::ate);
+  cout << "Mapped file is truncated to its length : " << mapped.tellg()
+       << endl;
+  std::remove("./mapped.txt");
+
+  {
+    testcaser::maker::sinks::MappedFileSink sink("./grown.txt", 4096, 4096);
+    std::size_t capacity;
+    char* window = sink.acquire(3, capacity);
+    // a growth that cannot be mapped must leave the window mapped
+    rlimit space, small = {256UL << 20, 256UL << 20};
+    getrlimit(RLIMIT_AS, &space);
+    setrlimit(RLIMIT_AS, &small);
+    bool grown = true;
+    try {
+      sink.reserve(1UL << 30);
+    } catch (std::exception const&) {
+      grown = false;
+    }
+    setrlimit(RLIMIT_AS, &space);
+    std::copy("abc", "abc" + 3, window);
+    sink.commit(3);
+    sink.close();
+    cout << "A failed growth keeps the mapping : " << !grown << endl;
+  }
+  std::remove("./grown.txt");
+
+  {
+    // the file may not outgrow its hint, a test ending less than _IO_BUFSIZ
+    // before the end of the mapping must not grow it to finalize
+    rlimit file, hint = {1 << 16, 1 << 16};
+    getrlimit(RLIMIT_FSIZE, &file);
+    setrlimit(RLIMIT_FSIZE, &hint);
+    signal(SIGXFSZ, SIG_IGN);
+    bool complete = true;
+    try {
+      TestCaseBuilder builder("./full.txt", 1 << 16);
+      builder.set_verbose(false);
+      for (int t = 0; t < 65000; t++) builder.add_line();
+      builder.finalize();
+    } catch (std::exception const&) {
+      complete = false;
+    }
+    setrlimit(RLIMIT_FSIZE, &file);
+    signal(SIGXFSZ, SIG_DFL);
+    std::ifstream full("./full.txt", std::ios::ate);
+    cout << "A test filling its mapping is finalized : "
+         << (complete && full.tellg() == 65000) << endl;
+  }
+  std::remove("./full.txt");
+#endif
+
+#ifdef __linux__
+  auto memfd = std::make_shared<testcaser::maker::sinks::MemfdSink>();
+  {
+    TestCaseBuilder builder(memfd);
+    builder.add_array(value, 5);
+    builder.finalize();
+  }
+  cout << "Memfd descriptor : " << memfd->descriptor() << endl;
+#endif
+  bool caught = false, finalized = true;
+  {
+    TestCaseBuilder builder(std::make_shared<FailingSink>());
+    builder.set_async_write(1 << 16);
+    try {
+      for (int t = 0; t < 300000; t++) builder.add_line();
+    } catch (std::runtime_error const&) {
+      caught = true;
+    }
+    try {
+      builder.finalize();
+    } catch (std::runtime_error const&) {
+      finalized = false;
+    }
+  }
+  cout << "A caught write error still fails finalize : "
+       << (caught && !finalized) << endl;
+  return 0;
+}
@@ -0,0 +1,68 @@
+/**
+ *   Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <testcaser/core/maker/suite.hpp>
+
+using std::cout;
+using std::endl;
+
+using testcaser::maker::FileReport;
+using testcaser::maker::SuiteFile;
+using testcaser::maker::TestSuiteBuilder;
+using testcaser::maker::types::RandomUnsignedInteger;
+
+std::string read(std::string const& path) {
+  std::ifstream file(path);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+int main() {
+  TestSuiteBuilder<std::size_t> suite(7);
+  for (std::size_t t = 0; t < 10; t++)
+    suite.add_file("./input0" + std::to_string(t) + ".txt", 1000 * (t + 1));
+
+  auto generate = [](SuiteFile<std::size_t>& file) {
+    if (file.index() == 9) throw std::runtime_error("input09 failed");
+    RandomUnsignedInteger<> value{{1, 1000000000}};
+    value.reseed_engine(file.seed(0));
+    file.builder().add_array(value, file.params());
+  };
+
+  auto reports = suite.build(generate, 4);
+  std::string const first = read("./input00.txt");
+  for (FileReport const& report : reports) {
+    cout << report.path << " : " << report.bytes << " bytes in "
+         << report.seconds << "s";
+    if (report.error) cout << " (failed)";
+    cout << endl;
+  }
+  suite.build(generate, 1);
+  cout << "Identical with 1 thread : " << (first == read("./input00.txt"))
+       << endl;
+  cout << "Failed file is removed : " << !std::ifstream("./input09.txt")
+       << endl;
+  for (std::size_t t = 0; t < 10; t++)
+    std::remove(("./input0" + std::to_string(t) + ".txt").c_str());
+  return 0;
+}
@@ -0,0 +1,84 @@
+/**
+ *   Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <testcaser/core/maker/randoms/RandomTypes.hpp>
+#include <testcaser/core/maker/randoms/threads.hpp>
+#include <thread>
+#include <vector>
+
+using std::cout;
+using std::endl;
+
+using testcaser::maker::threads::EngineRegistry;
+using testcaser::maker::threads::LocalEngine;
+using testcaser::maker::types::RandomInteger;
+
+// draws count values on every thread from a single shared object
+std::vector<std::vector<long long>> draw(RandomInteger<LocalEngine<>>& value,
+                                         unsigned threads, std::size_t count) {
+  std::vector<std::vector<long long>> values(threads,
+                                             std::vector<long long>(count));
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < threads; t++)
+    workers.emplace_back([&value, &values, t, count] {
+      EngineRegistry<>::bind(t);
+      value.fill(values[t].data(), count);
+    });
+  for (auto& worker : workers) worker.join();
+  return values;
+}
+
+int main() {
+  RandomInteger<LocalEngine<>> value{{-1000, 1000}};
+
+  EngineRegistry<>::seed(2019);
+  auto first = draw(value, 4, 100000);
+  EngineRegistry<>::seed(2019);
+  auto second = draw(value, 4, 100000);
+  cout << "Bound threads reproduce their streams : " << (first == second)
+       << endl;
+  cout << "Threads draw different streams : " << (first[0] != first[1])
+       << endl;
+
+  EngineRegistry<>::seed(2019);
+  EngineRegistry<>::bind(2);
+  bool same = true;
+  for (std::size_t t = 0; t < 1000; t++)
+    same = same && value.get() == first[2][t];
+  cout << "A stream only depends on its index : " << same << endl;
+
+  EngineRegistry<>::seed(7);
+  std::thread([] { EngineRegistry<>::engine(); }).join();
+  unsigned long long stream = 0;
+  std::thread([&stream] { stream = EngineRegistry<>::stream(); }).join();
+  cout << "Unbound threads take the next stream : "
+       << stream - EngineRegistry<>::first_unbound() << " (expected 1)"
+       << endl;
+
+  EngineRegistry<>::seed(2019);
+  std::vector<long long> unbound(1000);
+  std::thread([&value, &unbound] {
+    value.fill(unbound.data(), unbound.size());
+  }).join();
+  cout << "An unbound thread does not draw the stream 0 : "
+       << !std::equal(unbound.begin(), unbound.end(), first[0].begin())
+       << endl;
+  return 0;
+}
@@ -0,0 +1,150 @@
+/**
+ *   Copyright 2018-2019 Ashar <ashar786khan@gmail.com>
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef WRITER_HPP
+#define WRITER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <testcaser/core/maker/sinks.hpp>
+#include <thread>
+#include <vector>
+
+namespace testcaser {
+namespace maker {
+namespace sinks {
+/**
+ * @brief Writes buffers to a sink on a background thread. The owner fills one
+ * buffer while the writer writes the other one, the two are swapped by
+ * submit(..). The first error raised by the sink on the background thread is
+ * reported by every later submit(..) and drain(), and by finish().
+ *
+ */
+class BackgroundWriter {
+  std::shared_ptr<BaseSink> sink;
+  std::vector<char> pending;
+  std::size_t pending_size = 0;
+  bool has_pending = false;
+  bool stopping = false;
+  std::exception_ptr error;
+  std::mutex lock;
+  std::condition_variable changed;
+  std::thread worker;
+
+  void run() {
+    std::unique_lock<std::mutex> guard(lock);
+    for (;;) {
+      changed.wait(guard, [this] { return has_pending || stopping; });
+      if (!has_pending) return;
+      guard.unlock();
+      std::exception_ptr failure;
+      try {
+        sink->write(pending.data(), pending_size);
+      } catch (...) {
+        failure = std::current_exception();
+      }
+      guard.lock();
+      if (failure && !error) error = failure;
+      has_pending = false;
+      changed.notify_all();
+    }
+  }
+  /**
+   * @brief Waits for the buffer in flight to be written. Must be called with
+   * the lock held.
+   *
+   */
+  void wait_idle(std::unique_lock<std::mutex>& guard) {
+    changed.wait(guard, [this] { return !has_pending; });
+    // the error stays until finish(), the output is truncated even when the
+    // caller goes on
+    if (error) std::rethrow_exception(error);
+  }
+
+ public:
+  BackgroundWriter(BackgroundWriter const&) = delete;
+  BackgroundWriter& operator=(BackgroundWriter const&) = delete;
+  /**
+   * @brief Construct a new Background Writer object and starts its thread.
+   *
+   * @param output the sink to write to
+   * @param capacity the size of the buffers that will be submitted
+   */
+  BackgroundWriter(std::shared_ptr<BaseSink> output, std::size_t capacity)
+      : sink(output), pending(capacity) {
+    worker = std::thread(&BackgroundWriter::run, this);
+  }
+  /**
+   * @brief Hands the filled buffer to the background thread and gives back the
+   * buffer that was written before, blocking only while that one is still in
+   * flight.
+   *
+   * @param buffer the filled buffer. It is swapped with an empty one.
+   * @param size the number of bytes used in the buffer
+   */
+  void submit(std::vector<char>& buffer, std::size_t size) {
+    std::unique_lock<std::mutex> guard(lock);
+    this->wait_idle(guard);
+    if (size == 0) return;
+    pending.swap(buffer);
+    if (buffer.size() < pending.size()) buffer.resize(pending.size());
+    pending_size = size;
+    has_pending = true;
+    changed.notify_all();
+  }
+  /**
+   * @brief Waits until everything submitted has been written.
+   *
+   */
+  void drain() {
+    std::unique_lock<std::mutex> guard(lock);
+    this->wait_idle(guard);
+  }
+  /**
+   * @brief Writes everything submitted and stops the thread. Rethrows the first
+   * error raised by the sink.
+   *
+   */
+  void finish() {
+    std::unique_lock<std::mutex> guard(lock);
+    changed.wait(guard, [this] { return !has_pending; });
+    stopping = true;
+    changed.notify_all();
+    guard.unlock();
+    if (worker.joinable()) worker.join();
+    if (error) std::rethrow_exception(error);
+  }
+  /**
+   * @brief Destroy the Background Writer object. Any pending buffer is still
+   * written, errors are ignored.
+   *
+   */
+  ~BackgroundWriter() {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      stopping = true;
+      changed.notify_all();
+    }
+    if (worker.joinable()) worker.join();
+  }
+};
+}  // namespace sinks
+}  // namespace maker
+}  // namespace testcaser
+#endif
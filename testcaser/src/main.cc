@@ -14,8 +14,11 @@
  * limitations under the License.
  */
 
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <stdexcept>
+#include <string>
 #include <testcaser/integrator>
 #include <testcaser/src/argument_parser.hpp>
 
@@ -39,8 +42,15 @@ void show_help() {
           "to console.\n\n";
   cout << "--memory <number> : Sets the memory limit in MB for the Program. "
           "This is defaulted to 256 MB.\n\n";
-  cout << "--time <number> : Sets the time limit in seconds for the Program. "
-          "This is defaulted to 1 second.\n\n";
+  cout << "--time <number>[s|ms] : Sets the time limit for the Program, in "
+          "seconds or with the ms suffix in milliseconds, like 1.5 or 200ms. "
+          "It must be more than 0. This is defaulted to 1 second.\n\n";
+  cout << "--sample <number> : Sets the time in microseconds between two "
+          "samples of the memory used by the Program, from 0 to 1000000. "
+          "This is defaulted to 1000 microseconds.\n\n";
+  cout << "--clock <wall|cpu> : Sets the clock the time limit applies to, the "
+          "wall time or the CPU time of the Program. This is defaulted to "
+          "wall.\n\n";
   cout << "--help : Shows this message.\n\n";
   cout << "--version : Shows the current version of the Virtual Judge "
           "Installed.\n\n";
@@ -49,6 +59,39 @@ void show_help() {
           "MEANS A REQUIRED ARGUMENT.\n\n";
 }
 
+size_t parse_milliseconds(std::string const& value) {
+  std::string number = value;
+  double scale = 1000;
+  if (number.size() > 2 && number.compare(number.size() - 2, 2, "ms") == 0) {
+    number.erase(number.size() - 2);
+    scale = 1;
+  } else if (number.size() > 1 && number.back() == 's') {
+    number.erase(number.size() - 1);
+  }
+  size_t used = 0;
+  double const amount = std::stod(number, &used);
+  // the judge keeps the limit in microseconds too
+  double const largest =
+      static_cast<double>(std::numeric_limits<size_t>::max() / 1000);
+  // 0 is refused rather than clamped to a limit every program exceeds
+  if (used != number.size() || !std::isfinite(amount) || amount <= 0 ||
+      amount * scale >= largest)
+    throw std::invalid_argument("--time must be like 2, 1.5s or 200ms");
+  // a fraction of a millisecond is rounded up, 1.1 is not 1101 ms
+  return static_cast<size_t>(std::ceil(amount * scale - 1e-6));
+}
+
+size_t parse_microseconds(std::string const& value) {
+  size_t used = 0;
+  double const amount = std::stod(value, &used);
+  // memory sampled less than once a second would not be limited at all
+  if (used != value.size() || !std::isfinite(amount) || amount < 0 ||
+      amount > 1000000)
+    throw std::invalid_argument(
+        "--sample must be a number of microseconds from 0 to 1000000");
+  return static_cast<size_t>(std::ceil(amount));
+}
+
 int main(int argv, char* argc[]) {
   bool handled = ArgumentParser::handle_version(argv, argc, show_version);
   if (handled) return EXIT_SUCCESS;
@@ -70,10 +113,22 @@ int main(int argv, char* argc[]) {
     judge.set_input_file(map["input"]);
 
     if (map.find("time") != map.end())
-      judge.set_time_limit(std::stoi(map["time"]));
+      judge.set_time_limit_ms(parse_milliseconds(map["time"]));
     if (map.find("memory") != map.end())
       judge.set_memory_limit(std::stoi(map["memory"]) * 1024);
     if (map.find("output") != map.end()) judge.set_output_file(map["output"]);
+    if (map.find("sample") != map.end())
+      judge.set_sampling_interval(parse_microseconds(map["sample"]));
+    if (map.find("clock") != map.end()) {
+      if (map["clock"] == "cpu")
+        judge.set_time_limit_clock(testcaser::integrator::CPU_TIME);
+      else if (map["clock"] == "wall")
+        judge.set_time_limit_clock(testcaser::integrator::WALL_TIME);
+      else {
+        std::cerr << "Opps!! The --clock must be wall or cpu\n";
+        return EXIT_FAILURE;
+      }
+    }
 
     auto result = judge.execute();
     cout << "\n";